@@ -0,0 +1,163 @@
+/**
+ * @brief Implementation of dynamic bit-packed boolean vectors.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ctr/vector.hpp"
+
+namespace ctr {
+/**
+ * @brief Class for implementation of dynamic bit-packed boolean vectors.
+ *
+ *        The bits are packed into 32-bit words, bit i is held by bit
+ *        (i % WordBits) of word (i / WordBits). Unused bits of the last word
+ *        are always cleared, so whole words can be counted and combined
+ *        without masking.
+ */
+class BitVector {
+public:
+  /** The type of the words holding the bits. */
+  using Word = uint32_t;
+
+  /** The number of bits per word. */
+  static constexpr size_t WordBits{sizeof(Word) * 8U};
+
+  /**
+   * @brief Create empty bit vector.
+   */
+  BitVector() noexcept;
+
+  /**
+   * @brief Create bit vector of given size, all bits cleared.
+   *
+   * @param[in] bitCount The number of bits the vector holds.
+   */
+  explicit BitVector(const size_t bitCount) noexcept;
+
+  /**
+   * @brief Delete bit vector.
+   */
+  ~BitVector() noexcept = default;
+
+  /**
+   * @brief Get the number of bits held by the vector.
+   *
+   * @return The number of bits.
+   */
+  size_t size() const noexcept;
+
+  /**
+   * @brief Check if the vector is empty.
+   *
+   * @return True if the vector is empty, false otherwise.
+   */
+  bool empty() const noexcept;
+
+  /**
+   * @brief Get the number of words holding the bits.
+   *
+   * @return The number of words.
+   */
+  size_t wordCount() const noexcept;
+
+  /**
+   * @brief Get the words holding the bits.
+   *
+   * @return Pointer to the first word, nullptr if the vector is empty.
+   */
+  const Word *words() const noexcept;
+
+  /**
+   * @brief Get the word at given index.
+   *
+   * @param[in] index The word index, must be less than wordCount().
+   *
+   * @return The word at given index.
+   */
+  Word word(const size_t index) const noexcept;
+
+  /**
+   * @brief Get the bit at given index.
+   *
+   * @param[in] index The bit index, must be less than size().
+   *
+   * @return True if the bit is set, false otherwise.
+   */
+  bool test(const size_t index) const noexcept;
+
+  /**
+   * @brief Set the bit at given index.
+   *
+   * @param[in] index The bit index, must be less than size().
+   * @param[in] value The new value of the bit (default = true).
+   */
+  void set(const size_t index, const bool value = true) noexcept;
+
+  /**
+   * @brief Clear all bits, the size is kept.
+   */
+  void reset() noexcept;
+
+  /**
+   * @brief Count the set bits.
+   *
+   * @return The number of set bits.
+   */
+  size_t count() const noexcept;
+
+  /**
+   * @brief Clear content of vector.
+   */
+  void clear() noexcept;
+
+  /**
+   * @brief Resize the vector to given number of bits, all bits cleared.
+   *
+   * @param[in] bitCount The new number of bits.
+   *
+   * @return True if the vector was resized, false otherwise.
+   */
+  bool resize(const size_t bitCount) noexcept;
+
+  /**
+   * @brief Get the number of words needed for given number of bits.
+   *
+   * @param[in] bitCount The number of bits.
+   *
+   * @return The number of words.
+   */
+  static constexpr size_t wordsFor(const size_t bitCount) noexcept {
+    return (bitCount + WordBits - 1U) / WordBits;
+  }
+
+  /**
+   * @brief Count the set bits of a word.
+   *
+   * @param[in] word The word to count.
+   *
+   * @return The number of set bits.
+   */
+  static size_t popcount(const Word word) noexcept;
+
+  /**
+   * @brief Get the index of the lowest set bit of a word.
+   *
+   * @param[in] word The word to search, must not be 0.
+   *
+   * @return The index of the lowest set bit.
+   */
+  static size_t lowestBit(const Word word) noexcept;
+
+private:
+  /** The words holding the bits. */
+  Vector<Word> myWords;
+
+  /** The number of bits held by the vector. */
+  size_t myBitCount;
+};
+} // namespace ctr
+
+#include "impl/bit_vector_impl.hpp"
@@ -0,0 +1,96 @@
+/**
+ * @brief Implementation details of ctr::BitVector class.
+ *
+ * @note Don't include this header, use <bit_vector.hpp> instead!
+ */
+#pragma once
+
+namespace ctr {
+// -----------------------------------------------------------------------------
+inline BitVector::BitVector() noexcept : myWords{}, myBitCount{} {}
+
+// -----------------------------------------------------------------------------
+inline BitVector::BitVector(const size_t bitCount) noexcept : BitVector() {
+  resize(bitCount);
+}
+
+// -----------------------------------------------------------------------------
+inline size_t BitVector::size() const noexcept { return myBitCount; }
+
+// -----------------------------------------------------------------------------
+inline bool BitVector::empty() const noexcept { return 0U == myBitCount; }
+
+// -----------------------------------------------------------------------------
+inline size_t BitVector::wordCount() const noexcept { return myWords.size(); }
+
+// -----------------------------------------------------------------------------
+inline const BitVector::Word *BitVector::words() const noexcept {
+  return myWords.data();
+}
+
+// -----------------------------------------------------------------------------
+inline BitVector::Word BitVector::word(const size_t index) const noexcept {
+  return myWords[index];
+}
+
+// -----------------------------------------------------------------------------
+inline bool BitVector::test(const size_t index) const noexcept {
+  return 0U != (myWords[index / WordBits] & (Word{1U} << (index % WordBits)));
+}
+
+// -----------------------------------------------------------------------------
+inline void BitVector::set(const size_t index, const bool value) noexcept {
+  const Word mask{Word{1U} << (index % WordBits)};
+  auto &word{myWords[index / WordBits]};
+  word = value ? (word | mask) : (word & ~mask);
+}
+
+// -----------------------------------------------------------------------------
+inline void BitVector::reset() noexcept {
+  for (size_t i{}; i < myWords.size(); ++i) {
+    myWords[i] = 0U;
+  }
+}
+
+// -----------------------------------------------------------------------------
+inline size_t BitVector::count() const noexcept {
+  size_t result{};
+  for (size_t i{}; i < myWords.size(); ++i) {
+    result += popcount(myWords[i]);
+  }
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+inline void BitVector::clear() noexcept {
+  myWords.clear();
+  myBitCount = 0U;
+}
+
+// -----------------------------------------------------------------------------
+inline bool BitVector::resize(const size_t bitCount) noexcept {
+  const auto wordCount{wordsFor(bitCount)};
+
+  if (0U == wordCount) {
+    clear();
+    return true;
+  }
+  // Only reallocate if the number of words changes.
+  if ((wordCount != myWords.size()) && !myWords.resize(wordCount)) {
+    return false;
+  }
+  myBitCount = bitCount;
+  reset();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+inline size_t BitVector::popcount(const Word word) noexcept {
+  return static_cast<size_t>(__builtin_popcount(word));
+}
+
+// -----------------------------------------------------------------------------
+inline size_t BitVector::lowestBit(const Word word) noexcept {
+  return static_cast<size_t>(__builtin_ctz(word));
+}
+} // namespace ctr
@@ -3,25 +3,308 @@
  */
 #include "buttons/buttons.hpp"
 #include "display/display.hpp"
+#include "ml/dataset/sampler.hpp"
 #include "ml/dense_layer/dense_layer.hpp"
+#include "ml/dense_layer/kernels.hpp"
+#include "ml/fixed/single_layer.hpp"
+#include "ml/lr_schedule/reduce_on_plateau.hpp"
+#include "ml/model/flash_partition.hpp"
+#include "ml/model/header_exporter.hpp"
+#include "ml/model/memory_budget.hpp"
+#include "ml/model/model_view.hpp"
+#include "ml/model/static_model.hpp"
+#include "ml/model/writer.hpp"
+#include "ml/neural_network/incremental_predictor.hpp"
+#include "ml/neural_network/lookup_table.hpp"
 #include "ml/neural_network/single_layer.hpp"
+#include "ml/neural_network/width_shrinker.hpp"
+#include "ml/random/prng.hpp"
 #include "ml/types.hpp"
 #include <cstdint>
 #include <zephyr/kernel.h>
 #include <zephyr/sys/printk.h>
 
+// A model exported with ml::model::exportHeader() replaces training, the
+// integer one from ml::model::exportQuantizedHeader() is preferred.
+#if __has_include("ml/generated/digit_model_int8.hpp")
+#include "ml/generated/digit_model_int8.hpp"
+namespace generated = ml::generated::digit_model_int8;
+#define ML_GENERATED_MODEL
+#elif __has_include("ml/generated/digit_model.hpp")
+#include "ml/generated/digit_model.hpp"
+namespace generated = ml::generated::digit_model;
+#define ML_GENERATED_MODEL
+#endif
+
+namespace {
+#if !defined(ML_GENERATED_MODEL) && defined(CONFIG_ML_COMPILE_TIME_TRAINING)
+/** Training set of the digit model, three button bits to digits 0 - 7. */
+constexpr double digitInputs[8U][3U]{{0.0, 0.0, 0.0}, {0.0, 0.0, 1.0},
+                                     {0.0, 1.0, 0.0}, {0.0, 1.0, 1.0},
+                                     {1.0, 0.0, 0.0}, {1.0, 0.0, 1.0},
+                                     {1.0, 1.0, 0.0}, {1.0, 1.0, 1.0}};
+constexpr double digitOutputs[8U][1U]{{0.0}, {1.0}, {2.0}, {3.0},
+                                      {4.0}, {5.0}, {6.0}, {7.0}};
+
+// Train the digit model while compiling.
+constexpr ml::fixed::SingleLayer<3U, 3U, 1U> trainDigitModel() {
+  constexpr uint64_t seed{3U};
+  constexpr double learningRate{0.05};
+  constexpr size_t maxEpochs{1000U};
+
+  ml::random::Prng prng{seed};
+  ml::fixed::SingleLayer<3U, 3U, 1U> model{prng};
+  model.train(digitInputs, digitOutputs, learningRate, maxEpochs);
+  return model;
+}
+
+/** The digit model trained by the compiler, kept in read-only data. */
+constexpr auto digitModel{trainDigitModel()};
+
+static_assert(digitModel.isPredictDone(digitInputs, digitOutputs),
+              "the compile-time digit model doesn't meet the tolerance");
+#endif
+
+// Extract the digit from the model output.
+uint8_t toDigit(const double *output, const size_t outputCount) {
+  // Classifiers have one output per digit, the largest one wins.
+  if (1U < outputCount) {
+    return static_cast<uint8_t>(ml::dense_layer::argmax(output, outputCount));
+  }
+  // Regression models output the digit itself, round to the nearest integer.
+  double out = output[0];
+  if (out < 0.0)
+    out = 0.0;
+  if (out > 7.0)
+    out = 7.0;
+  return static_cast<uint8_t>(out);
+}
+
+// Show the digit predicted for the button states, never returns.
+template <typename Predict> void run(Predict predict) {
+  uint8_t lastDigit = 0;
+  double input[3U]{};
+
+  while (1) {
+    // Continuously monitor the buttons.
+    input[0] = static_cast<double>(button0_get());
+    input[1] = static_cast<double>(button1_get());
+    input[2] = static_cast<double>(button2_get());
+
+    const uint8_t digit{predict(input)};
+
+    // Update the displayed digit on change.
+    if (digit != lastDigit) {
+      lastDigit = digit;
+      display_set_value(digit);
+    }
+    k_msleep(10);
+  }
+}
+
+#if !defined(ML_GENERATED_MODEL) &&                                            \
+    !defined(CONFIG_ML_COMPILE_TIME_TRAINING) &&                               \
+    !defined(CONFIG_ML_INFERENCE_ONLY)
+// Store the trained layers in flash, so the next boot can skip training.
+void storeModel(const ml::dense_layer::Interface &hiddenLayer,
+                const ml::dense_layer::Interface &outputLayer,
+                ml::model::FlashPartition &partition) {
+  const ml::dense_layer::Interface *const layers[]{&hiddenLayer, &outputLayer};
+  constexpr size_t layerCount{sizeof(layers) / sizeof(layers[0])};
+  constexpr auto scalarType{ml::model::ScalarType::Float32};
+
+  // Models are a multiple of 8 bytes, 64-bit words keep the buffer aligned.
+  const size_t size{ml::model::requiredBytes(layers, layerCount, scalarType)};
+  const size_t wordCount{size / sizeof(uint64_t)};
+  ctr::Vector<uint64_t> buffer(wordCount);
+
+  if ((0U == size) || (wordCount != buffer.size()) ||
+      (size != ml::model::save(layers, layerCount, scalarType, &buffer[0],
+                               size)) ||
+      !partition.store(&buffer[0], size)) {
+    printk("Model not stored\n");
+    return;
+  }
+  printk("Model stored: %u bytes\n", (unsigned)size);
+}
+
+// Calibrate the fake quantization input ranges of both layers.
+bool calibrate(ml::dense_layer::DenseLayer &hiddenLayer,
+               ml::dense_layer::DenseLayer &outputLayer,
+               const ml::Matrix2d &inputs) {
+  for (const auto &input : inputs) {
+    hiddenLayer.calibrate(input);
+  }
+  // The output layer sees the quantized hidden outputs.
+  for (const auto &input : inputs) {
+    if (!hiddenLayer.feedforward(input)) {
+      return false;
+    }
+    outputLayer.calibrate(hiddenLayer.output());
+  }
+  return true;
+}
+
+// Fine-tune with simulated 8-bit weights and inputs and print the integer
+// model, then restore the full-precision weights, which are the ones stored
+// in flash. Returns false if the weights couldn't be kept.
+bool exportInt8(ml::neural_network::SingleLayer &network,
+                ml::dense_layer::DenseLayer &hiddenLayer,
+                ml::dense_layer::DenseLayer &outputLayer,
+                const ml::Matrix2d &inputs, const double learningRate) {
+  const ml::Matrix2d hiddenWeights{hiddenLayer.weights()};
+  const ml::Matrix1d hiddenBias{hiddenLayer.bias()};
+  const ml::Matrix2d outputWeights{outputLayer.weights()};
+  const ml::Matrix1d outputBias{outputLayer.bias()};
+
+  if ((hiddenWeights.size() != hiddenLayer.nodeCount()) ||
+      (hiddenBias.size() != hiddenLayer.nodeCount()) ||
+      (outputWeights.size() != outputLayer.nodeCount()) ||
+      (outputBias.size() != outputLayer.nodeCount())) {
+    return false;
+  }
+  // The input ranges are calibrated on the training set first, since
+  // fine-tuning may not need a single update.
+  const ml::dense_layer::DenseLayer *const layers[]{&hiddenLayer,
+                                                    &outputLayer};
+  if (hiddenLayer.setFakeQuant(ml::Quantization::Int8) &&
+      outputLayer.setFakeQuant(ml::Quantization::Int8) &&
+      calibrate(hiddenLayer, outputLayer, inputs) &&
+      network.train(learningRate, 1U, 1000U)) {
+    ml::model::exportQuantizedHeader(layers, 2U, "digit_model_int8",
+                                     ml::model::printkSink);
+  }
+  return hiddenLayer.setFakeQuant(ml::Quantization::None) &&
+         outputLayer.setFakeQuant(ml::Quantization::None) &&
+         hiddenLayer.setParameters(hiddenWeights, hiddenBias) &&
+         outputLayer.setParameters(outputWeights, outputBias);
+}
+
+// Show the digits the predictor predicts for the button states, never
+// returns.
+void serve(ml::neural_network::Interface &predictor,
+           const ml::Matrix2d &inputs, const size_t outputCount) {
+  // The inputs are button bits, so all 8 predictions fit in a table and
+  // every prediction becomes a single load.
+  ml::neural_network::LookupTable table{};
+  if (table.detectDomain(inputs) && table.compile(predictor) &&
+      table.verify(predictor, inputs)) {
+    printk("Lookup table: %u entries\n", (unsigned)table.entryCount());
+    run([&table](const double (&input)[3U]) {
+      return toDigit(table.entry(table.index(input)), table.outputCount());
+    });
+  }
+
+  ml::Matrix1d networkInput{0.0, 0.0, 0.0};
+
+  run([&predictor, &networkInput, outputCount](const double (&input)[3U]) {
+    for (size_t i{}; i < networkInput.size(); ++i) {
+      networkInput[i] = input[i];
+    }
+    return toDigit(predictor.predict(networkInput).data(), outputCount);
+  });
+}
+#endif
+} // namespace
+
 extern "C" int main(void) {
   display_init();
   buttons_init_irq();
   display_set_value(0);
 
-  uint8_t lastDigit = 0;
+#ifdef ML_GENERATED_MODEL
+  // The weights are in read-only data, ready without any training.
+  run([](const double (&input)[3U]) {
+    double output[generated::model.outputCount()]{};
+    generated::predict(input, output);
+    return toDigit(output, generated::model.outputCount());
+  });
+#elif defined(CONFIG_ML_COMPILE_TIME_TRAINING)
+  // The model was trained by the compiler, nothing to do at runtime.
+  printk("Epochs used at compile time: %u\n",
+         (unsigned)digitModel.getEpochsUsed());
+  run([](const double (&input)[3U]) {
+    double output[1U]{};
+    digitModel.predict(input, output);
+    return toDigit(output, 1U);
+  });
+#elif defined(CONFIG_ML_INFERENCE_ONLY)
+  // Run the model a training build stored in flash. The partition is mapped
+  // when it's opened, so the weights are read in place.
+  ml::model::FlashPartition partition{};
+  ml::model::ModelView model{};
 
+  if (!partition.open() || !model.load(partition.data(), partition.size()) ||
+      (3U != model.inputCount())) {
+    printk("No model in flash, run a training build first\n");
+    return -1;
+  }
+  ml::Matrix1d networkInput{0.0, 0.0, 0.0};
+
+  run([&model, &networkInput](const double (&input)[3U]) {
+    for (size_t i{}; i < networkInput.size(); ++i) {
+      networkInput[i] = input[i];
+    }
+    return toDigit(model.predict(networkInput).data(), model.outputCount());
+  });
+#else
   constexpr size_t inputCount{3U};
-  constexpr size_t hiddenCount{3U};
-  constexpr size_t outputCount{1U};
+  constexpr size_t maxHiddenCount{8U};
+  constexpr size_t outputCount{8U};
+
+#ifdef CONFIG_HEAP_MEM_POOL_SIZE
+  // Fail the build instead of running out of heap. main() never returns, so
+  // everything allocated before serve() stays on the heap. Every block is
+  // counted at the widest hidden layer, shrinking only frees memory.
+  using ml::model::heapBlockBytes;
+  using ml::model::matrixBytes;
+  using ml::model::vectorBytes;
+  constexpr size_t sampleCount{8U};
+  constexpr size_t entryCount{1U << inputCount}; // Two levels per button.
+  constexpr size_t widths[]{inputCount, maxHiddenCount, outputCount};
+  // The integer export fine-tunes with fake quantization, its buffers and the
+  // gradients optimize() allocates for it stay on the heap afterwards.
+  constexpr auto budget{ml::model::memoryBudget(
+      widths, 3U, ml::model::ScalarType::Float32, ml::Optimizer::None, 1U,
+      ml::Quantization::Int8)};
+  constexpr size_t hiddenBytes{vectorBytes<double>(maxHiddenCount)};
+  constexpr size_t outputBytes{vectorBytes<double>(outputCount)};
+  constexpr size_t parameterBytes{
+      matrixBytes(maxHiddenCount, inputCount) + hiddenBytes +
+      matrixBytes(outputCount, maxHiddenCount) + outputBytes};
+
+  // Blocks that stay allocated until serve() runs: the training sets, the
+  // header the partition copies from an empty flash, the sampler order, the
+  // shrinker's parameter copy, saliency and mean outputs, the predictor's
+  // input, sums, hidden outputs and outputs, and the lookup table with its
+  // output and the input serve() keeps. Nothing is pruned, so there are no
+  // pruning masks.
+  constexpr size_t residentBytes{
+      matrixBytes(sampleCount, inputCount) +
+      matrixBytes(sampleCount, outputCount) +
+      heapBlockBytes(sizeof(ml::model::Header)) +
+      vectorBytes<uint32_t>(sampleCount) + parameterBytes + 2U * hiddenBytes +
+      vectorBytes<double>(inputCount) + 2U * hiddenBytes + outputBytes +
+      vectorBytes<double>(entryCount * outputCount) + outputBytes +
+      vectorBytes<double>(inputCount)};
 
-  constexpr double learningRate{0.1};
+  // Blocks that are freed again, only one group is alive at a time: the
+  // smaller parameters of WidthShrinker::removeNode() while a layer reshapes
+  // one row at a time, which also bounds the parameter snapshots of
+  // findLearningRate() and exportInt8(), and the model buffer of
+  // storeModel().
+  constexpr size_t shrinkBytes{parameterBytes + budget.transient};
+  constexpr size_t storeBytes{heapBlockBytes(budget.model)};
+  constexpr size_t transientBytes{
+      shrinkBytes < storeBytes ? storeBytes : shrinkBytes};
+
+  // Blocks of different sizes are freed and allocated again while the
+  // hidden layer shrinks, a quarter on top covers the fragmentation.
+  constexpr size_t peakBytes{budget.heapBytes() + residentBytes +
+                             transientBytes};
+  static_assert(peakBytes + peakBytes / 4U <= CONFIG_HEAP_MEM_POOL_SIZE,
+                "the model doesn't fit the heap, see prj.conf");
+#endif
 
   const ml::Matrix2d trainInputSets{
       ml::Matrix1d{0.0, 0.0, 0.0}, ml::Matrix1d{0.0, 0.0, 1.0},
@@ -29,49 +312,94 @@ extern "C" int main(void) {
       ml::Matrix1d{1.0, 0.0, 0.0}, ml::Matrix1d{1.0, 0.0, 1.0},
       ml::Matrix1d{1.0, 1.0, 0.0}, ml::Matrix1d{1.0, 1.0, 1.0}};
 
-  const ml::Matrix2d trainOutputSets{ml::Matrix1d{0.0}, ml::Matrix1d{1.0},
-                                     ml::Matrix1d{2.0}, ml::Matrix1d{3.0},
-                                     ml::Matrix1d{4.0}, ml::Matrix1d{5.0},
-                                     ml::Matrix1d{6.0}, ml::Matrix1d{7.0}};
+  // Use the model stored in flash if there is one, which skips training and
+  // leaves the heap to the model.
+  ml::model::FlashPartition partition{};
+  ml::model::ModelView model{};
+
+  if (partition.open() && model.load(partition.data(), partition.size()) &&
+      (inputCount == model.inputCount()) &&
+      (outputCount == model.outputCount())) {
+    printk("Model loaded from flash\n");
+    serve(model, trainInputSets, outputCount);
+  }
+
+  // One output per digit, the right one is 1 and the others 0.
+  const ml::Matrix2d trainOutputSets{
+      ml::Matrix1d{1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+      ml::Matrix1d{0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+      ml::Matrix1d{0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 0.0},
+      ml::Matrix1d{0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0},
+      ml::Matrix1d{0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0},
+      ml::Matrix1d{0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0},
+      ml::Matrix1d{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0},
+      ml::Matrix1d{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0}};
 
-  ml::dense_layer::DenseLayer hiddenLayer{hiddenCount, inputCount};
-  ml::dense_layer::DenseLayer outputLayer{outputCount, hiddenCount};
+  // Draw the initial weights from a fixed seed, so every run is the same.
+  ml::random::Prng prng{ml::random::Prng::DefaultSeed};
+
+  // Start with a wide hidden layer, training shrinks it to what's needed. The
+  // softmax output layer classifies, training stops once every digit is
+  // right.
+  ml::dense_layer::DenseLayer hiddenLayer{maxHiddenCount, inputCount, prng};
+  ml::dense_layer::DenseLayer outputLayer{outputCount, maxHiddenCount, prng,
+                                          ml::ActFunc::Softmax};
   ml::neural_network::SingleLayer network{hiddenLayer, outputLayer,
                                           trainInputSets, trainOutputSets};
 
-  // Train the model once before starting the logic loop, return -1 on failure.
-  if (!network.train(learningRate)) {
+  // Visit the samples in a new random order every epoch, return -1 on
+  // failure.
+  ml::dataset::Sampler sampler{prng};
+  if (!network.setSampler(sampler)) {
+    return -1;
+  }
+
+  // Pick the learning rate with a short range test, return -1 on failure.
+  const double learningRate{network.findLearningRate()};
+  if (0.0 >= learningRate) {
+    return -1;
+  }
+  printk("Learning rate: %d.%06d\n", static_cast<int>(learningRate),
+         static_cast<int>(learningRate * 1e6) % 1000000);
+
+  // Train the model once before starting the logic loop, halving the rate
+  // whenever the loss stalls, return -1 on failure.
+  ml::lr_schedule::ReduceOnPlateau schedule{learningRate};
+  if (!network.train(schedule)) {
     return -1;
   }
 
   // Print the amount of epochs the algoritm used.
   printk("Epochs used:  %d\n", network.getEpochsUsed());
 
-  ml::Matrix1d trainInput{0.0, 0.0, 0.0};
+  // Remove the hidden nodes the model can do without, return -1 on failure.
+  ml::neural_network::WidthShrinker shrinker{hiddenLayer, outputLayer,
+                                             trainInputSets, trainOutputSets};
+  if (!shrinker.shrink(learningRate)) {
+    return -1;
+  }
+  printk("Hidden nodes: %u\n", (unsigned)hiddenLayer.nodeCount());
+  storeModel(hiddenLayer, outputLayer, partition);
 
-  while (1) {
-    // Continuously monitor the buttons.
-    trainInput[0] = static_cast<double>(button0_get());
-    trainInput[1] = static_cast<double>(button1_get());
-    trainInput[2] = static_cast<double>(button2_get());
-
-    // The output vector only consists of one value, which is the digit to
-    // display.
-    const double output{network.predict(trainInput)[0]};
-
-    // Extract the digit, round to the nearest integer.
-    double out = output;
-    if (out < 0.0)
-      out = 0.0;
-    if (out > 7.0)
-      out = 7.0;
-    const uint8_t digit = static_cast<uint8_t>(out);
+  // Print the model as header, saved as src/ml/generated/digit_model.hpp it
+  // replaces training in the next build.
+  const ml::dense_layer::Interface *const layers[]{&hiddenLayer, &outputLayer};
+  ml::model::exportHeader(layers, 2U, "digit_model",
+                          ml::model::ScalarType::Float32,
+                          ml::model::printkSink);
 
-    // Update the displayed digit on change.
-    if (digit != lastDigit) {
-      lastDigit = digit;
-      display_set_value(digit);
-    }
-    k_msleep(10);
+  // Print the integer model as well, saved as
+  // src/ml/generated/digit_model_int8.hpp. The runtime predictor below uses
+  // the full-precision weights stored in flash, return -1 on failure.
+  if (!exportInt8(network, hiddenLayer, outputLayer, trainInputSets,
+                  learningRate)) {
+    return -1;
   }
+
+  // Usually a single button changes at a time, so the trained network only
+  // updates the hidden sums of the inputs that changed.
+  ml::neural_network::IncrementalPredictor predictor{hiddenLayer,
+                                                     outputLayer};
+  serve(predictor, trainInputSets, outputCount);
+#endif
 }
@@ -0,0 +1,59 @@
+/**
+ * @brief Dataset stored as constant arrays implementation details.
+ */
+#include <zephyr/sys/printk.h>
+
+#include "ml/dataset/array_dataset.hpp"
+#include "ml/dense_layer/kernels.hpp"
+
+namespace ml::dataset {
+// -----------------------------------------------------------------------------
+ArrayDataset::ArrayDataset(const double *inputs, const double *outputs,
+                           const size_t sampleCount, const size_t inputCount,
+                           const size_t outputCount) noexcept
+    : myInputs{inputs}, myOutputs{outputs}, mySampleCount{}, myInput{},
+      myOutput{} {
+  using ml::dense_layer::resizeZero;
+
+  // On error the dataset stays empty.
+  if ((nullptr == inputs) || (nullptr == outputs) || (0U == inputCount) ||
+      (0U == outputCount)) {
+    printk("invalid dataset parameters\n");
+    return;
+  }
+  if (!resizeZero(myInput, inputCount) || !resizeZero(myOutput, outputCount)) {
+    printk("failed to allocate dataset buffers\n");
+    return;
+  }
+  mySampleCount = sampleCount;
+}
+
+// -----------------------------------------------------------------------------
+size_t ArrayDataset::sampleCount() const noexcept { return mySampleCount; }
+
+// -----------------------------------------------------------------------------
+size_t ArrayDataset::inputCount() const noexcept { return myInput.size(); }
+
+// -----------------------------------------------------------------------------
+size_t ArrayDataset::outputCount() const noexcept { return myOutput.size(); }
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &ArrayDataset::input(const size_t index) noexcept {
+  const auto values{myInputs + index * myInput.size()};
+
+  for (size_t j{}; j < myInput.size(); ++j) {
+    myInput[j] = values[j];
+  }
+  return myInput;
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &ArrayDataset::output(const size_t index) noexcept {
+  const auto values{myOutputs + index * myOutput.size()};
+
+  for (size_t i{}; i < myOutput.size(); ++i) {
+    myOutput[i] = values[i];
+  }
+  return myOutput;
+}
+} // namespace ml::dataset
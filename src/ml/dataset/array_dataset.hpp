@@ -0,0 +1,120 @@
+/**
+ * @brief Dataset stored as constant arrays.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/dataset/interface.hpp"
+#include "ml/types.hpp"
+
+namespace ml::dataset {
+/**
+ * @brief Dataset stored as constant arrays.
+ *
+ *        The samples stay in read-only data, e.g. constexpr arrays placed in
+ *        flash, and only the sample being trained on is copied to RAM. Memory
+ *        use is one input and one output vector, whatever the sample count.
+ */
+class ArrayDataset final : public Interface {
+public:
+  /**
+   * @brief Create a new dataset on top of the given arrays.
+   *
+   * @param[in] inputs The input values, [sample][input].
+   * @param[in] outputs The output values, [sample][output].
+   * @param[in] sampleCount The number of samples.
+   * @param[in] inputCount The number of input values per sample. Must
+   *                       exceed 0.
+   * @param[in] outputCount The number of output values per sample. Must
+   *                        exceed 0.
+   */
+  explicit ArrayDataset(const double *inputs, const double *outputs,
+                        const size_t sampleCount, const size_t inputCount,
+                        const size_t outputCount) noexcept;
+
+  /**
+   * @brief Create a new dataset on top of the given arrays.
+   *
+   * @tparam SampleCount The number of samples.
+   * @tparam InputCount The number of input values per sample.
+   * @tparam OutputCount The number of output values per sample.
+   *
+   * @param[in] inputs The input values.
+   * @param[in] outputs The output values.
+   */
+  template <size_t SampleCount, size_t InputCount, size_t OutputCount>
+  explicit ArrayDataset(
+      const double (&inputs)[SampleCount][InputCount],
+      const double (&outputs)[SampleCount][OutputCount]) noexcept
+      : ArrayDataset{&inputs[0U][0U], &outputs[0U][0U], SampleCount,
+                     InputCount, OutputCount} {}
+
+  /**
+   * @brief Delete the dataset.
+   */
+  ~ArrayDataset() noexcept override = default;
+
+  /**
+   * @brief Get the number of samples in the dataset.
+   *
+   * @return The number of samples, 0 if the parameters were invalid or the
+   *         sample buffers couldn't be allocated.
+   */
+  size_t sampleCount() const noexcept override;
+
+  /**
+   * @brief Get the number of input values per sample.
+   *
+   * @return The number of input values.
+   */
+  size_t inputCount() const noexcept override;
+
+  /**
+   * @brief Get the number of output values per sample.
+   *
+   * @return The number of output values.
+   */
+  size_t outputCount() const noexcept override;
+
+  /**
+   * @brief Get the input values of a sample.
+   *
+   * @param[in] index The index of the sample, below sampleCount().
+   *
+   * @return Vector holding the input values, valid until the next call.
+   */
+  const ml::Matrix1d &input(const size_t index) noexcept override;
+
+  /**
+   * @brief Get the output values of a sample.
+   *
+   * @param[in] index The index of the sample, below sampleCount().
+   *
+   * @return Vector holding the output values, valid until the next call.
+   */
+  const ml::Matrix1d &output(const size_t index) noexcept override;
+
+  ArrayDataset() = delete;                                // No default.
+  ArrayDataset(const ArrayDataset &) = delete;            // No copy.
+  ArrayDataset(ArrayDataset &&) = delete;                 // No move.
+  ArrayDataset &operator=(const ArrayDataset &) = delete; // No copy.
+  ArrayDataset &operator=(ArrayDataset &&) = delete;      // No move.
+
+private:
+  /** The input values, [sample][input]. */
+  const double *myInputs;
+
+  /** The output values, [sample][output]. */
+  const double *myOutputs;
+
+  /** The number of samples. */
+  size_t mySampleCount;
+
+  /** Input values of the last fetched sample. */
+  ml::Matrix1d myInput;
+
+  /** Output values of the last fetched sample. */
+  ml::Matrix1d myOutput;
+};
+} // namespace ml::dataset
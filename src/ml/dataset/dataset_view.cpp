@@ -0,0 +1,95 @@
+/**
+ * @brief In-place view of a binary dataset implementation details.
+ */
+#include <zephyr/sys/printk.h>
+
+#include "ml/dataset/dataset_view.hpp"
+#include "ml/dense_layer/kernels.hpp"
+
+namespace ml::dataset {
+// -----------------------------------------------------------------------------
+DatasetView::DatasetView() noexcept
+    : mySamples{nullptr}, mySampleCount{}, mySampleBytes{},
+      myScalarType{ml::model::ScalarType::Float64}, myInput{}, myOutput{} {}
+
+// -----------------------------------------------------------------------------
+bool DatasetView::load(const void *data, const size_t size) noexcept {
+  using ml::dense_layer::resizeZero;
+  using ml::model::ScalarType;
+  mySamples = nullptr;
+  mySampleCount = 0U;
+
+  if ((nullptr == data) || (sizeof(Header) > size) ||
+      (0U != reinterpret_cast<uintptr_t>(data) % ml::model::Alignment)) {
+    printk("invalid dataset location\n");
+    return false;
+  }
+  const auto &header{*static_cast<const Header *>(data)};
+
+  if ((Magic != header.magic) || (Version != header.version) ||
+      (static_cast<uint8_t>(ScalarType::Float32) < header.scalarType) ||
+      (0U == header.inputCount) || (0U == header.outputCount)) {
+    printk("invalid dataset header\n");
+    return false;
+  }
+  // Only the buffers of a single sample are allocated.
+  if (!resizeZero(myInput, header.inputCount) ||
+      !resizeZero(myOutput, header.outputCount)) {
+    printk("failed to allocate dataset buffers\n");
+    return false;
+  }
+  myScalarType = static_cast<ScalarType>(header.scalarType);
+  mySampleBytes =
+      sampleBytes(header.inputCount, header.outputCount, myScalarType);
+  mySampleCount = (size - sizeof(Header)) / mySampleBytes;
+  mySamples = static_cast<const uint8_t *>(data) + sizeof(Header);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+size_t DatasetView::sampleCount() const noexcept { return mySampleCount; }
+
+// -----------------------------------------------------------------------------
+size_t DatasetView::inputCount() const noexcept {
+  return nullptr != mySamples ? myInput.size() : 0U;
+}
+
+// -----------------------------------------------------------------------------
+size_t DatasetView::outputCount() const noexcept {
+  return nullptr != mySamples ? myOutput.size() : 0U;
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &DatasetView::input(const size_t index) noexcept {
+  decode(index * mySampleBytes, myInput);
+  return myInput;
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &DatasetView::output(const size_t index) noexcept {
+  // The output values follow the input values of the sample.
+  decode(index * mySampleBytes +
+             myInput.size() * ml::model::scalarSize(myScalarType),
+         myOutput);
+  return myOutput;
+}
+
+// -----------------------------------------------------------------------------
+void DatasetView::decode(const size_t offset,
+                         ml::Matrix1d &values) const noexcept {
+  // Samples are aligned to the scalar size, the values are read in place.
+  if (ml::model::ScalarType::Float32 == myScalarType) {
+    const auto source{reinterpret_cast<const float *>(mySamples + offset)};
+
+    for (size_t i{}; i < values.size(); ++i) {
+      values[i] = source[i];
+    }
+  } else {
+    const auto source{reinterpret_cast<const double *>(mySamples + offset)};
+
+    for (size_t i{}; i < values.size(); ++i) {
+      values[i] = source[i];
+    }
+  }
+}
+} // namespace ml::dataset
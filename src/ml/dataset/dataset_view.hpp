@@ -0,0 +1,114 @@
+/**
+ * @brief In-place view of a binary dataset.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ml/dataset/format.hpp"
+#include "ml/dataset/interface.hpp"
+#include "ml/model/format.hpp"
+#include "ml/types.hpp"
+
+namespace ml::dataset {
+/**
+ * @brief In-place view of a binary dataset.
+ *
+ *        The view validates the header and reads every sample straight from
+ *        the dataset bytes, nothing is loaded up front. The bytes may live
+ *        anywhere the CPU can read, e.g. a memory-mapped flash partition or
+ *        a memory-mapped file on the host (see ml::model::MappedFile), and
+ *        must outlive the view. Memory use is one input and one output
+ *        vector, whatever the sample count.
+ */
+class DatasetView final : public Interface {
+public:
+  /**
+   * @brief Create a new view without a dataset.
+   */
+  DatasetView() noexcept;
+
+  /**
+   * @brief Delete the view.
+   */
+  ~DatasetView() noexcept override = default;
+
+  /**
+   * @brief Validate the given bytes and use them as dataset.
+   *
+   *        On failure, the view holds no samples.
+   *
+   * @param[in] data The dataset bytes, must be 8-byte aligned.
+   * @param[in] size The number of available bytes.
+   *
+   * @return True if the dataset was loaded, or false on error.
+   */
+  bool load(const void *data, const size_t size) noexcept;
+
+  /**
+   * @brief Get the number of samples in the dataset.
+   *
+   * @return The number of complete samples, 0 if no dataset is loaded.
+   */
+  size_t sampleCount() const noexcept override;
+
+  /**
+   * @brief Get the number of input values per sample.
+   *
+   * @return The number of input values, 0 if no dataset is loaded.
+   */
+  size_t inputCount() const noexcept override;
+
+  /**
+   * @brief Get the number of output values per sample.
+   *
+   * @return The number of output values, 0 if no dataset is loaded.
+   */
+  size_t outputCount() const noexcept override;
+
+  /**
+   * @brief Get the input values of a sample.
+   *
+   * @param[in] index The index of the sample, below sampleCount().
+   *
+   * @return Vector holding the input values, valid until the next call.
+   */
+  const ml::Matrix1d &input(const size_t index) noexcept override;
+
+  /**
+   * @brief Get the output values of a sample.
+   *
+   * @param[in] index The index of the sample, below sampleCount().
+   *
+   * @return Vector holding the output values, valid until the next call.
+   */
+  const ml::Matrix1d &output(const size_t index) noexcept override;
+
+  DatasetView(const DatasetView &) = delete;            // No copy.
+  DatasetView(DatasetView &&) = delete;                 // No move.
+  DatasetView &operator=(const DatasetView &) = delete; // No copy.
+  DatasetView &operator=(DatasetView &&) = delete;      // No move.
+
+private:
+  void decode(const size_t offset, ml::Matrix1d &values) const noexcept;
+
+  /** The first sample, nullptr if no dataset is loaded. */
+  const uint8_t *mySamples;
+
+  /** The number of complete samples. */
+  size_t mySampleCount;
+
+  /** The size of one sample in bytes. */
+  size_t mySampleBytes;
+
+  /** The scalar type of the values. */
+  ml::model::ScalarType myScalarType;
+
+  /** Input values of the last fetched sample. */
+  ml::Matrix1d myInput;
+
+  /** Output values of the last fetched sample. */
+  ml::Matrix1d myOutput;
+};
+} // namespace ml::dataset
@@ -0,0 +1,61 @@
+/**
+ * @brief Binary dataset format.
+ *
+ *        A dataset file holds a header followed by the samples, each the
+ *        input values followed by the output values in the scalar type:
+ *
+ *        Header     magic, version, scalar type, input count and output count
+ *                   (16 bytes).
+ *        Sample     input values [input], output values [output].
+ *
+ *        Every sample has the same size, so sample k starts at
+ *        sizeof(Header) + k * sampleBytes() and can be read in place. The
+ *        sample count follows from the file size, which lets a logger append
+ *        samples without ever rewriting the header. A trailing partial
+ *        sample, e.g. from an interrupted write, is ignored.
+ *
+ *        All values are stored little-endian, as in the model format (see
+ *        ml/model/format.hpp).
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ml/model/format.hpp"
+
+namespace ml::dataset {
+/** Identifies a dataset file, "MLDS" in memory. */
+constexpr uint32_t Magic{0x53444C4DU};
+
+/** The current format version. */
+constexpr uint16_t Version{1U};
+
+/**
+ * @brief Dataset header.
+ */
+struct Header {
+  uint32_t magic;       ///< Always Magic.
+  uint16_t version;     ///< Format version of the dataset.
+  uint8_t scalarType;   ///< ml::model::ScalarType of the values.
+  uint8_t reserved;     ///< Always zero.
+  uint32_t inputCount;  ///< The number of input values per sample.
+  uint32_t outputCount; ///< The number of output values per sample.
+};
+
+static_assert(16U == sizeof(Header), "unexpected dataset header padding");
+
+/**
+ * @brief Get the size of a sample.
+ *
+ * @param[in] inputCount The number of input values per sample.
+ * @param[in] outputCount The number of output values per sample.
+ * @param[in] scalarType The scalar type of the values.
+ *
+ * @return The size of one sample in bytes.
+ */
+constexpr size_t sampleBytes(const size_t inputCount, const size_t outputCount,
+                             const ml::model::ScalarType scalarType) noexcept {
+  return (inputCount + outputCount) * ml::model::scalarSize(scalarType);
+}
+} // namespace ml::dataset
@@ -0,0 +1,66 @@
+/**
+ * @brief Training dataset interface.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/types.hpp"
+
+namespace ml::dataset {
+/**
+ * @brief Training dataset interface.
+ *
+ *        A dataset is a pull source of samples, each an input vector and the
+ *        output vector the model should predict for it. Samples are fetched
+ *        one at a time by index, so a dataset doesn't need to fit the heap:
+ *        implementations may decode each sample from flash or a mapped file
+ *        into a buffer of their own.
+ */
+class Interface {
+public:
+  /**
+   * @brief Delete the dataset.
+   */
+  virtual ~Interface() noexcept = default;
+
+  /**
+   * @brief Get the number of samples in the dataset.
+   *
+   * @return The number of samples.
+   */
+  virtual size_t sampleCount() const noexcept = 0;
+
+  /**
+   * @brief Get the number of input values per sample.
+   *
+   * @return The number of input values.
+   */
+  virtual size_t inputCount() const noexcept = 0;
+
+  /**
+   * @brief Get the number of output values per sample.
+   *
+   * @return The number of output values.
+   */
+  virtual size_t outputCount() const noexcept = 0;
+
+  /**
+   * @brief Get the input values of a sample.
+   *
+   * @param[in] index The index of the sample, below sampleCount().
+   *
+   * @return Vector holding the input values, valid until the next call.
+   */
+  virtual const ml::Matrix1d &input(const size_t index) noexcept = 0;
+
+  /**
+   * @brief Get the output values of a sample.
+   *
+   * @param[in] index The index of the sample, below sampleCount().
+   *
+   * @return Vector holding the output values, valid until the next call.
+   */
+  virtual const ml::Matrix1d &output(const size_t index) noexcept = 0;
+};
+} // namespace ml::dataset
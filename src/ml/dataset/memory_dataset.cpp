@@ -0,0 +1,40 @@
+/**
+ * @brief Dataset held in RAM implementation details.
+ */
+#include "ml/dataset/memory_dataset.hpp"
+
+namespace ml::dataset {
+// -----------------------------------------------------------------------------
+MemoryDataset::MemoryDataset() noexcept
+    : myInputs{nullptr}, myOutputs{nullptr}, mySampleCount{} {}
+
+// -----------------------------------------------------------------------------
+MemoryDataset::MemoryDataset(const ml::Matrix2d &inputs,
+                             const ml::Matrix2d &outputs) noexcept
+    : myInputs{&inputs}, myOutputs{&outputs},
+      mySampleCount{inputs.size() <= outputs.size() ? inputs.size()
+                                                    : outputs.size()} {}
+
+// -----------------------------------------------------------------------------
+size_t MemoryDataset::sampleCount() const noexcept { return mySampleCount; }
+
+// -----------------------------------------------------------------------------
+size_t MemoryDataset::inputCount() const noexcept {
+  return 0U < mySampleCount ? (*myInputs)[0U].size() : 0U;
+}
+
+// -----------------------------------------------------------------------------
+size_t MemoryDataset::outputCount() const noexcept {
+  return 0U < mySampleCount ? (*myOutputs)[0U].size() : 0U;
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &MemoryDataset::input(const size_t index) noexcept {
+  return (*myInputs)[index];
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &MemoryDataset::output(const size_t index) noexcept {
+  return (*myOutputs)[index];
+}
+} // namespace ml::dataset
@@ -0,0 +1,94 @@
+/**
+ * @brief Dataset held in RAM.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/dataset/interface.hpp"
+#include "ml/types.hpp"
+
+namespace ml::dataset {
+/**
+ * @brief Dataset held in RAM.
+ *
+ *        Wraps an input and an output matrix, the samples are returned in
+ *        place without copying. The matrices must outlive the dataset.
+ */
+class MemoryDataset final : public Interface {
+public:
+  /**
+   * @brief Create a new dataset without samples.
+   */
+  MemoryDataset() noexcept;
+
+  /**
+   * @brief Create a new dataset on top of the given matrices.
+   *
+   * @param[in] inputs The input values, [sample][input].
+   * @param[in] outputs The output values, [sample][output]. Samples beyond
+   *                    the shorter of both matrices are ignored.
+   */
+  explicit MemoryDataset(const ml::Matrix2d &inputs,
+                         const ml::Matrix2d &outputs) noexcept;
+
+  /**
+   * @brief Delete the dataset.
+   */
+  ~MemoryDataset() noexcept override = default;
+
+  /**
+   * @brief Get the number of samples in the dataset.
+   *
+   * @return The number of samples.
+   */
+  size_t sampleCount() const noexcept override;
+
+  /**
+   * @brief Get the number of input values per sample.
+   *
+   * @return The number of input values of the first sample, 0 if empty.
+   */
+  size_t inputCount() const noexcept override;
+
+  /**
+   * @brief Get the number of output values per sample.
+   *
+   * @return The number of output values of the first sample, 0 if empty.
+   */
+  size_t outputCount() const noexcept override;
+
+  /**
+   * @brief Get the input values of a sample.
+   *
+   * @param[in] index The index of the sample, below sampleCount().
+   *
+   * @return Reference to the row of the input matrix.
+   */
+  const ml::Matrix1d &input(const size_t index) noexcept override;
+
+  /**
+   * @brief Get the output values of a sample.
+   *
+   * @param[in] index The index of the sample, below sampleCount().
+   *
+   * @return Reference to the row of the output matrix.
+   */
+  const ml::Matrix1d &output(const size_t index) noexcept override;
+
+  MemoryDataset(const MemoryDataset &) = delete;            // No copy.
+  MemoryDataset(MemoryDataset &&) = delete;                 // No move.
+  MemoryDataset &operator=(const MemoryDataset &) = delete; // No copy.
+  MemoryDataset &operator=(MemoryDataset &&) = delete;      // No move.
+
+private:
+  /** The input values, nullptr without samples. */
+  const ml::Matrix2d *myInputs;
+
+  /** The output values, nullptr without samples. */
+  const ml::Matrix2d *myOutputs;
+
+  /** The number of samples. */
+  size_t mySampleCount;
+};
+} // namespace ml::dataset
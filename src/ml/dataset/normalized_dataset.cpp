@@ -0,0 +1,51 @@
+/**
+ * @brief Dataset normalizing the inputs of another dataset implementation
+ *        details.
+ */
+#include <zephyr/sys/printk.h>
+
+#include "ml/dataset/normalized_dataset.hpp"
+#include "ml/dense_layer/kernels.hpp"
+
+namespace ml::dataset {
+// -----------------------------------------------------------------------------
+NormalizedDataset::NormalizedDataset(Interface &source,
+                                     const Normalizer &normalizer) noexcept
+    : mySource{source}, myNormalizer{normalizer}, myInput{} {
+  // On error the dataset stays empty.
+  if ((0U == normalizer.inputCount()) ||
+      (source.inputCount() != normalizer.inputCount())) {
+    printk("normalizer doesn't match the dataset\n");
+    return;
+  }
+  if (!ml::dense_layer::resizeZero(myInput, source.inputCount())) {
+    printk("failed to allocate dataset buffers\n");
+  }
+}
+
+// -----------------------------------------------------------------------------
+size_t NormalizedDataset::sampleCount() const noexcept {
+  return 0U == myInput.size() ? 0U : mySource.sampleCount();
+}
+
+// -----------------------------------------------------------------------------
+size_t NormalizedDataset::inputCount() const noexcept {
+  return myInput.size();
+}
+
+// -----------------------------------------------------------------------------
+size_t NormalizedDataset::outputCount() const noexcept {
+  return mySource.outputCount();
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &NormalizedDataset::input(const size_t index) noexcept {
+  myNormalizer.apply(mySource.input(index), myInput);
+  return myInput;
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &NormalizedDataset::output(const size_t index) noexcept {
+  return mySource.output(index);
+}
+} // namespace ml::dataset
@@ -0,0 +1,92 @@
+/**
+ * @brief Dataset normalizing the inputs of another dataset.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/dataset/interface.hpp"
+#include "ml/dataset/normalizer.hpp"
+#include "ml/types.hpp"
+
+namespace ml::dataset {
+/**
+ * @brief Dataset normalizing the inputs of another dataset.
+ *
+ *        Inputs are normalized on the fly as they are fetched, outputs are
+ *        passed through. Memory use is one input vector, the source dataset
+ *        is left untouched.
+ */
+class NormalizedDataset final : public Interface {
+public:
+  /**
+   * @brief Create a new dataset on top of the given dataset.
+   *
+   * @param[in] source The dataset holding the raw samples.
+   * @param[in] normalizer The normalizer to apply, fitted to inputs of the
+   *                       same size as the source. Must outlive the dataset.
+   */
+  explicit NormalizedDataset(Interface &source,
+                             const Normalizer &normalizer) noexcept;
+
+  /**
+   * @brief Delete the dataset.
+   */
+  ~NormalizedDataset() noexcept override = default;
+
+  /**
+   * @brief Get the number of samples in the dataset.
+   *
+   * @return The number of samples, 0 if the normalizer doesn't match the
+   *         source or the input buffer couldn't be allocated.
+   */
+  size_t sampleCount() const noexcept override;
+
+  /**
+   * @brief Get the number of input values per sample.
+   *
+   * @return The number of input values.
+   */
+  size_t inputCount() const noexcept override;
+
+  /**
+   * @brief Get the number of output values per sample.
+   *
+   * @return The number of output values.
+   */
+  size_t outputCount() const noexcept override;
+
+  /**
+   * @brief Get the normalized input values of a sample.
+   *
+   * @param[in] index The index of the sample, below sampleCount().
+   *
+   * @return Vector holding the input values, valid until the next call.
+   */
+  const ml::Matrix1d &input(const size_t index) noexcept override;
+
+  /**
+   * @brief Get the output values of a sample.
+   *
+   * @param[in] index The index of the sample, below sampleCount().
+   *
+   * @return Vector holding the output values, valid until the next call.
+   */
+  const ml::Matrix1d &output(const size_t index) noexcept override;
+
+  NormalizedDataset(const NormalizedDataset &) = delete;            // No copy.
+  NormalizedDataset(NormalizedDataset &&) = delete;                 // No move.
+  NormalizedDataset &operator=(const NormalizedDataset &) = delete; // No copy.
+  NormalizedDataset &operator=(NormalizedDataset &&) = delete;      // No move.
+
+private:
+  /** The dataset holding the raw samples. */
+  Interface &mySource;
+
+  /** The normalizer to apply. */
+  const Normalizer &myNormalizer;
+
+  /** Normalized input values of the last fetched sample. */
+  ml::Matrix1d myInput;
+};
+} // namespace ml::dataset
@@ -0,0 +1,107 @@
+/**
+ * @brief Input normalization implementation details.
+ */
+#include <math.h>
+
+#include <zephyr/sys/printk.h>
+
+#include "ml/dataset/normalizer.hpp"
+#include "ml/dense_layer/kernels.hpp"
+
+namespace ml::dataset {
+// -----------------------------------------------------------------------------
+Normalizer::Normalizer(const ml::Normalization normalization) noexcept
+    : myNormalization{normalization}, myShift{}, myScale{} {}
+
+// -----------------------------------------------------------------------------
+bool Normalizer::fit(Interface &dataset) noexcept {
+  using ml::dense_layer::resizeZero;
+  const auto sampleCount{dataset.sampleCount()};
+  const auto inputCount{dataset.inputCount()};
+  myShift.clear();
+
+  if ((0U == sampleCount) || (0U == inputCount)) {
+    printk("invalid normalizer dataset\n");
+    return false;
+  }
+  if (!resizeZero(myShift, inputCount) || !resizeZero(myScale, inputCount)) {
+    printk("failed to allocate normalizer\n");
+    myShift.clear();
+    return false;
+  }
+  const bool isMinMax{ml::Normalization::MinMax == myNormalization};
+
+  // One pass: Welford's mean and squared deviation sum for standardizing,
+  // min and max for min-max. The scale holds the deviation sum or the max
+  // until the end.
+  for (size_t k{}; k < sampleCount; ++k) {
+    const auto &input{dataset.input(k)};
+
+    for (size_t j{}; j < inputCount; ++j) {
+      if (isMinMax) {
+        myShift[j] = 0U == k ? input[j] : fmin(myShift[j], input[j]);
+        myScale[j] = 0U == k ? input[j] : fmax(myScale[j], input[j]);
+      } else {
+        const auto delta{input[j] - myShift[j]};
+        myShift[j] += delta / (k + 1U);
+        myScale[j] += delta * (input[j] - myShift[j]);
+      }
+    }
+  }
+  for (size_t j{}; j < inputCount; ++j) {
+    const auto spread{isMinMax ? myScale[j] - myShift[j]
+                               : sqrt(myScale[j] / sampleCount)};
+
+    // Constant inputs are only shifted.
+    myScale[j] = 0.0 < spread ? 1.0 / spread : 1.0;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+size_t Normalizer::inputCount() const noexcept { return myShift.size(); }
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &Normalizer::shift() const noexcept { return myShift; }
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &Normalizer::scale() const noexcept { return myScale; }
+
+// -----------------------------------------------------------------------------
+bool Normalizer::apply(const ml::Matrix1d &input,
+                       ml::Matrix1d &normalized) const noexcept {
+  if ((0U == inputCount()) || (input.size() != inputCount()) ||
+      (normalized.size() != inputCount())) {
+    printk("normalizer dimension mismatch\n");
+    return false;
+  }
+  for (size_t j{}; j < input.size(); ++j) {
+    normalized[j] = (input[j] - myShift[j]) * myScale[j];
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool Normalizer::fold(ml::dense_layer::Interface &firstLayer) const noexcept {
+  if ((0U == inputCount()) || (firstLayer.weightCount() != inputCount())) {
+    printk("normalizer dimension mismatch\n");
+    return false;
+  }
+  ml::Matrix2d weights{firstLayer.weights()};
+  ml::Matrix1d bias{firstLayer.bias()};
+
+  if ((weights.size() != firstLayer.nodeCount()) ||
+      (bias.size() != firstLayer.nodeCount())) {
+    printk("failed to allocate normalizer\n");
+    return false;
+  }
+  // w * (x - shift) * scale = (w * scale) * x - w * scale * shift
+  for (size_t i{}; i < weights.size(); ++i) {
+    for (size_t j{}; j < inputCount(); ++j) {
+      weights[i][j] *= myScale[j];
+      bias[i] -= weights[i][j] * myShift[j];
+    }
+  }
+  return firstLayer.setParameters(weights, bias);
+}
+} // namespace ml::dataset
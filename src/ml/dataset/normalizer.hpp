@@ -0,0 +1,124 @@
+/**
+ * @brief Input normalization, foldable into the first layer.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/dataset/interface.hpp"
+#include "ml/dense_layer/interface.hpp"
+#include "ml/types.hpp"
+
+namespace ml::dataset {
+/**
+ * @brief Input normalization, foldable into the first layer.
+ *
+ *        Maps every input value to normalized[j] = (input[j] - shift[j]) *
+ *        scale[j], with the statistics of a dataset gathered in one streaming
+ *        pass:
+ *
+ *        Standardize  shift = mean, scale = 1 / standard deviation.
+ *        MinMax       shift = min, scale = 1 / (max - min).
+ *
+ *        Inputs that never change keep scale 1. Training on normalized
+ *        inputs (see NormalizedDataset) converges faster when the raw inputs
+ *        have very different scales. Since the normalization is affine, it
+ *        can afterwards be folded into the weights and bias of the first
+ *        layer, which then takes raw inputs at no extra inference cost.
+ */
+class Normalizer final {
+public:
+  /**
+   * @brief Create a new normalizer without statistics.
+   *
+   * @param[in] normalization The normalization to use (default =
+   *                          Standardize).
+   */
+  explicit Normalizer(
+      const ml::Normalization normalization =
+          ml::Normalization::Standardize) noexcept;
+
+  /**
+   * @brief Delete the normalizer.
+   */
+  ~Normalizer() noexcept = default;
+
+  /**
+   * @brief Gather the statistics of the inputs of the given dataset.
+   *
+   *        Reads every sample once, memory use doesn't depend on the sample
+   *        count.
+   *
+   * @param[in] dataset The dataset to gather the statistics of.
+   *
+   * @return True if the statistics were gathered, or false on error.
+   */
+  bool fit(Interface &dataset) noexcept;
+
+  /**
+   * @brief Get the number of inputs of the gathered statistics.
+   *
+   * @return The number of inputs, 0 before fit().
+   */
+  size_t inputCount() const noexcept;
+
+  /**
+   * @brief Get the value subtracted from each input.
+   *
+   * @return Vector holding the shift of each input.
+   */
+  const ml::Matrix1d &shift() const noexcept;
+
+  /**
+   * @brief Get the factor each shifted input is multiplied with.
+   *
+   * @return Vector holding the scale of each input.
+   */
+  const ml::Matrix1d &scale() const noexcept;
+
+  /**
+   * @brief Normalize the given input.
+   *
+   * @param[in] input The raw input values, must hold inputCount() values.
+   * @param[out] normalized The normalized values, must hold inputCount()
+   *                        values.
+   *
+   * @return True if the input was normalized, or false on dimension
+   *         mismatch.
+   */
+  bool apply(const ml::Matrix1d &input,
+             ml::Matrix1d &normalized) const noexcept;
+
+  /**
+   * @brief Fold the normalization into the given layer.
+   *
+   *        The layer must have been trained on normalized inputs. Afterwards
+   *        it gives the same output for raw inputs:
+   *
+   *        weight'[i][j] = weight[i][j] * scale[j]
+   *        bias'[i] = bias[i] - sum(weight[i][j] * scale[j] * shift[j])
+   *
+   *        Fold right before export, further training must use raw inputs.
+   *
+   * @param[in, out] firstLayer The first layer of the trained model.
+   *
+   * @return True if the normalization was folded, or false on error.
+   */
+  bool fold(ml::dense_layer::Interface &firstLayer) const noexcept;
+
+  Normalizer(const Normalizer &) = delete;            // No copy.
+  Normalizer(Normalizer &&) = delete;                 // No move.
+  Normalizer &operator=(const Normalizer &) = delete; // No copy.
+  Normalizer &operator=(Normalizer &&) = delete;      // No move.
+
+private:
+  /** The normalization to use. */
+  const ml::Normalization myNormalization;
+
+  /** The value subtracted from each input. */
+  ml::Matrix1d myShift;
+
+  /** The factor each shifted input is multiplied with. */
+  ml::Matrix1d myScale;
+};
+} // namespace ml::dataset
@@ -0,0 +1,255 @@
+/**
+ * @brief Epoch sampler implementation details.
+ */
+#include <math.h>
+
+#include <zephyr/sys/printk.h>
+
+#include "ml/dataset/sampler.hpp"
+
+namespace ml::dataset {
+namespace {
+// -----------------------------------------------------------------------------
+bool resizeIndices(ctr::Vector<uint32_t> &indices, const size_t size) noexcept {
+  // Resizing always reallocates, keep vectors that already fit.
+  return (indices.size() == size) || indices.resize(size);
+}
+
+// -----------------------------------------------------------------------------
+uint8_t classOf(const ml::Matrix1d &output) noexcept {
+  size_t label{};
+
+  if (1U < output.size()) {
+    // One output per class, the largest one wins.
+    for (size_t i{1U}; i < output.size(); ++i) {
+      if (output[i] > output[label]) {
+        label = i;
+      }
+    }
+  } else if (0.0 < output[0U]) {
+    const auto rounded{round(output[0U])};
+    label = rounded < Sampler::MaxClassCount - 1U
+                ? static_cast<size_t>(rounded)
+                : Sampler::MaxClassCount - 1U;
+  }
+  return static_cast<uint8_t>(
+      label < Sampler::MaxClassCount ? label : Sampler::MaxClassCount - 1U);
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+Sampler::Sampler(ml::random::Prng &prng, const ml::SampleOrder order) noexcept
+    : myPrng{prng}, myOrder{order}, myIndices{}, myGrouped{}, myClassStart{},
+      myTaken{}, myWeights{} {}
+
+// -----------------------------------------------------------------------------
+bool Sampler::init(Interface &dataset) noexcept {
+  const auto sampleCount{dataset.sampleCount()};
+  myWeights.clear();
+
+  if ((0U == sampleCount) || (UINT32_MAX < sampleCount) ||
+      (0U == dataset.outputCount())) {
+    printk("invalid sampler dataset\n");
+    myIndices.clear();
+    return false;
+  }
+  if (!resizeIndices(myIndices, sampleCount)) {
+    printk("failed to allocate sampler indices\n");
+    return false;
+  }
+  for (size_t k{}; k < sampleCount; ++k) {
+    myIndices[k] = static_cast<uint32_t>(k);
+  }
+  if ((ml::SampleOrder::Stratified == myOrder) ||
+      (ml::SampleOrder::Balanced == myOrder)) {
+    return groupClasses(dataset);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool Sampler::setWeights(const ml::Matrix1d &weights) noexcept {
+  if (weights.empty()) {
+    myWeights.clear();
+    return true;
+  }
+  if (weights.size() != myIndices.size()) {
+    printk("sample weight count mismatch\n");
+    return false;
+  }
+  for (const auto weight : weights) {
+    if (!(0.0 <= weight)) {
+      printk("invalid sample weight\n");
+      return false;
+    }
+  }
+  myWeights = weights;
+  return myWeights.size() == weights.size();
+}
+
+// -----------------------------------------------------------------------------
+void Sampler::nextEpoch() noexcept {
+  switch (myOrder) {
+  case ml::SampleOrder::Shuffled:
+    shuffle(myIndices, 0U, myIndices.size());
+    break;
+  case ml::SampleOrder::Stratified:
+    stratify();
+    break;
+  case ml::SampleOrder::Balanced:
+    balance();
+    break;
+  default:
+    break;
+  }
+}
+
+// -----------------------------------------------------------------------------
+size_t Sampler::size() const noexcept { return myIndices.size(); }
+
+// -----------------------------------------------------------------------------
+size_t Sampler::index(const size_t position) const noexcept {
+  return myIndices[position];
+}
+
+// -----------------------------------------------------------------------------
+double Sampler::weight(const size_t position) const noexcept {
+  return myWeights.empty() ? 1.0 : myWeights[myIndices[position]];
+}
+
+// -----------------------------------------------------------------------------
+ml::SampleOrder Sampler::order() const noexcept { return myOrder; }
+
+// -----------------------------------------------------------------------------
+size_t Sampler::classCount() const noexcept {
+  return myClassStart.empty() ? 0U : myClassStart.size() - 1U;
+}
+
+// -----------------------------------------------------------------------------
+bool Sampler::groupClasses(Interface &dataset) noexcept {
+  const auto sampleCount{myIndices.size()};
+  ctr::Vector<uint8_t> labels(sampleCount);
+  ctr::Vector<uint32_t> counts(size_t{MaxClassCount});
+
+  myClassStart.clear();
+
+  if ((labels.size() != sampleCount) || (counts.size() != MaxClassCount)) {
+    printk("failed to allocate sampler classes\n");
+    return false;
+  }
+  for (size_t label{}; label < MaxClassCount; ++label) {
+    counts[label] = 0U;
+  }
+  // Read every output once, only the class is kept.
+  uint32_t classCount{};
+
+  for (size_t k{}; k < sampleCount; ++k) {
+    labels[k] = classOf(dataset.output(k));
+
+    if (0U == counts[labels[k]]++) {
+      ++classCount;
+    }
+  }
+  if (!resizeIndices(myGrouped, sampleCount) ||
+      !resizeIndices(myClassStart, classCount + 1U) ||
+      !resizeIndices(myTaken, classCount)) {
+    printk("failed to allocate sampler classes\n");
+    myClassStart.clear();
+    return false;
+  }
+  // Number the non-empty classes, counts becomes the class of each label.
+  uint32_t next{};
+  myClassStart[0U] = 0U;
+
+  for (size_t label{}; label < MaxClassCount; ++label) {
+    if (0U < counts[label]) {
+      myClassStart[next + 1U] = myClassStart[next] + counts[label];
+      myTaken[next] = 0U;
+      counts[label] = next++;
+    }
+  }
+  // Counting sort of the samples by class, the class offsets are the cursors.
+  for (size_t k{}; k < sampleCount; ++k) {
+    const auto c{counts[labels[k]]};
+    myGrouped[myClassStart[c] + myTaken[c]++] = static_cast<uint32_t>(k);
+  }
+  for (size_t c{}; c < classCount; ++c) {
+    myTaken[c] = 0U;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+void Sampler::shuffle(ctr::Vector<uint32_t> &indices, const size_t begin,
+                      const size_t end) noexcept {
+  // Fisher-Yates, every permutation is equally likely.
+  for (size_t i{end}; begin + 1U < i; --i) {
+    const auto j{begin + myPrng.index(i - begin)};
+    const auto index{indices[i - 1U]};
+    indices[i - 1U] = indices[j];
+    indices[j] = index;
+  }
+}
+
+// -----------------------------------------------------------------------------
+void Sampler::stratify() noexcept {
+  const auto classCount{this->classCount()};
+
+  if (0U == classCount) {
+    return;
+  }
+  for (size_t c{}; c < classCount; ++c) {
+    shuffle(myGrouped, myClassStart[c], myClassStart[c + 1U]);
+    myTaken[c] = 0U;
+  }
+  // Take next from the class whose share of the epoch is most overdue, so
+  // every class is spread evenly. Ties go to the first class from a random
+  // start, which varies the order of equally sized classes.
+  const auto first{myPrng.index(classCount)};
+
+  for (size_t position{}; position < myIndices.size(); ++position) {
+    size_t next{classCount};
+    double nextDue{};
+
+    for (size_t i{}; i < classCount; ++i) {
+      const auto c{(first + i) % classCount};
+      const auto count{myClassStart[c + 1U] - myClassStart[c]};
+
+      if (myTaken[c] < count) {
+        const double due{(myTaken[c] + 0.5) / count};
+
+        if ((classCount == next) || (due < nextDue)) {
+          next = c;
+          nextDue = due;
+        }
+      }
+    }
+    myIndices[position] = myGrouped[myClassStart[next] + myTaken[next]++];
+  }
+}
+
+// -----------------------------------------------------------------------------
+void Sampler::balance() noexcept {
+  const auto classCount{this->classCount()};
+
+  if (0U == classCount) {
+    return;
+  }
+  // The classes take turns, each continues where its last turn stopped and
+  // is reshuffled whenever all of its samples were taken.
+  for (size_t position{}; position < myIndices.size(); ++position) {
+    const auto c{position % classCount};
+    const auto begin{myClassStart[c]};
+    const auto count{myClassStart[c + 1U] - begin};
+    const auto offset{myTaken[c] % count};
+
+    if (0U == offset) {
+      shuffle(myGrouped, begin, begin + count);
+    }
+    myIndices[position] = myGrouped[begin + offset];
+    myTaken[c] = offset + 1U;
+  }
+  // Mix the turns, the share of every class stays the same.
+  shuffle(myIndices, 0U, myIndices.size());
+}
+} // namespace ml::dataset
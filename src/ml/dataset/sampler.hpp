@@ -0,0 +1,163 @@
+/**
+ * @brief Epoch sampler producing sample index permutations.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ctr/vector.hpp"
+#include "ml/dataset/interface.hpp"
+#include "ml/random/prng.hpp"
+#include "ml/types.hpp"
+
+namespace ml::dataset {
+/**
+ * @brief Epoch sampler producing sample index permutations.
+ *
+ *        Decides in which order the samples of a dataset are visited each
+ *        epoch. Only the 32-bit sample indices are permuted, the samples
+ *        themselves are never moved, so it works for datasets of any size
+ *        and source:
+ *
+ *        Sequential  0 to n - 1, the same every epoch.
+ *        Shuffled    Fisher-Yates shuffle of the indices every epoch.
+ *        Stratified  Every class is shuffled on its own, then the classes are
+ *                    interleaved so that each part of the epoch holds them in
+ *                    their dataset proportions.
+ *        Balanced    The classes take turns, so every class gets the same
+ *                    share of the epoch. Small classes are repeated and large
+ *                    ones are only partly visited, the next epoch continues
+ *                    where this one stopped.
+ *
+ *        The class of a sample is the index of its largest output value, or
+ *        its single output value rounded and clamped to 0 - MaxClassCount - 1.
+ *
+ *        Optional per-sample weights scale how much each sample contributes
+ *        to training, e.g. to emphasize rare or important samples.
+ */
+class Sampler final {
+public:
+  /** The maximum number of classes for stratified and balanced orders. */
+  static constexpr size_t MaxClassCount{256U};
+
+  /**
+   * @brief Create a new sampler.
+   *
+   * @param[in] prng The generator to shuffle with.
+   * @param[in] order The sample order (default = Shuffled).
+   */
+  explicit Sampler(
+      ml::random::Prng &prng,
+      const ml::SampleOrder order = ml::SampleOrder::Shuffled) noexcept;
+
+  /**
+   * @brief Delete the sampler.
+   */
+  ~Sampler() noexcept = default;
+
+  /**
+   * @brief Prepare the sampler for the given dataset.
+   *
+   *        Allocates the permutation and, for stratified and balanced orders,
+   *        reads the outputs of every sample once to find its class. Clears
+   *        the sample weights.
+   *
+   * @param[in] dataset The dataset to sample from.
+   *
+   * @return True if the sampler was prepared, or false on error.
+   */
+  bool init(Interface &dataset) noexcept;
+
+  /**
+   * @brief Set the sample weights.
+   *
+   * @param[in] weights The weight of each sample, at least 0, or an empty
+   *                    vector to weigh all samples 1. Samples with weight 0
+   *                    are skipped.
+   *
+   * @return True if the weights were set, or false if they don't match the
+   *         dataset or on allocation failure.
+   */
+  bool setWeights(const ml::Matrix1d &weights) noexcept;
+
+  /**
+   * @brief Generate the sample order of the next epoch.
+   */
+  void nextEpoch() noexcept;
+
+  /**
+   * @brief Get the number of samples per epoch.
+   *
+   * @return The number of samples, 0 before init().
+   */
+  size_t size() const noexcept;
+
+  /**
+   * @brief Get the sample at the given position of the epoch.
+   *
+   * @param[in] position The position in the epoch, below size().
+   *
+   * @return The index of the sample.
+   */
+  size_t index(const size_t position) const noexcept;
+
+  /**
+   * @brief Get the weight of the sample at the given position of the epoch.
+   *
+   * @param[in] position The position in the epoch, below size().
+   *
+   * @return The weight of the sample, 1 without sample weights.
+   */
+  double weight(const size_t position) const noexcept;
+
+  /**
+   * @brief Get the sample order.
+   *
+   * @return The sample order.
+   */
+  ml::SampleOrder order() const noexcept;
+
+  /**
+   * @brief Get the number of classes found by init().
+   *
+   * @return The number of non-empty classes, 0 for sequential and shuffled
+   *         orders.
+   */
+  size_t classCount() const noexcept;
+
+  Sampler() = delete;                           // No default.
+  Sampler(const Sampler &) = delete;            // No copy.
+  Sampler(Sampler &&) = delete;                 // No move.
+  Sampler &operator=(const Sampler &) = delete; // No copy.
+  Sampler &operator=(Sampler &&) = delete;      // No move.
+
+private:
+  bool groupClasses(Interface &dataset) noexcept;
+  void shuffle(ctr::Vector<uint32_t> &indices, const size_t begin,
+               const size_t end) noexcept;
+  void stratify() noexcept;
+  void balance() noexcept;
+
+  /** The generator to shuffle with. */
+  ml::random::Prng &myPrng;
+
+  /** The sample order. */
+  const ml::SampleOrder myOrder;
+
+  /** The sample indices of the epoch. */
+  ctr::Vector<uint32_t> myIndices;
+
+  /** The sample indices grouped by class, each class shuffled on its own. */
+  ctr::Vector<uint32_t> myGrouped;
+
+  /** Offset of each class in the grouped indices, plus the total count. */
+  ctr::Vector<uint32_t> myClassStart;
+
+  /** The number of samples taken from each class. */
+  ctr::Vector<uint32_t> myTaken;
+
+  /** The weight of each sample, empty if all samples weigh 1. */
+  ml::Matrix1d myWeights;
+};
+} // namespace ml::dataset
@@ -0,0 +1,60 @@
+/**
+ * @brief Writer encoding samples in the binary dataset format implementation
+ *        details.
+ */
+#include <stdint.h>
+
+#include <zephyr/sys/printk.h>
+
+#include "ml/dataset/writer.hpp"
+
+namespace ml::dataset {
+namespace {
+// -----------------------------------------------------------------------------
+template <typename T>
+T *encodeValues(const ml::Matrix1d &values, T *target) noexcept {
+  for (const auto value : values) {
+    *target++ = static_cast<T>(value);
+  }
+  return target;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+bool encodeHeader(const size_t inputCount, const size_t outputCount,
+                  const ml::model::ScalarType scalarType,
+                  Header &header) noexcept {
+  if ((0U == inputCount) || (0U == outputCount) ||
+      (UINT32_MAX < inputCount) || (UINT32_MAX < outputCount)) {
+    printk("invalid dataset dimensions\n");
+    return false;
+  }
+  header = Header{Magic,
+                  Version,
+                  static_cast<uint8_t>(scalarType),
+                  0U,
+                  static_cast<uint32_t>(inputCount),
+                  static_cast<uint32_t>(outputCount)};
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+size_t encodeSample(const ml::Matrix1d &input, const ml::Matrix1d &output,
+                    const ml::model::ScalarType scalarType, void *buffer,
+                    const size_t size) noexcept {
+  const auto bytes{sampleBytes(input.size(), output.size(), scalarType)};
+
+  if ((nullptr == buffer) || (size < bytes) ||
+      (0U != reinterpret_cast<uintptr_t>(buffer) %
+                 ml::model::scalarSize(scalarType))) {
+    printk("invalid dataset sample buffer\n");
+    return 0U;
+  }
+  if (ml::model::ScalarType::Float32 == scalarType) {
+    encodeValues(output, encodeValues(input, static_cast<float *>(buffer)));
+  } else {
+    encodeValues(output, encodeValues(input, static_cast<double *>(buffer)));
+  }
+  return bytes;
+}
+} // namespace ml::dataset
@@ -0,0 +1,44 @@
+/**
+ * @brief Writer encoding samples in the binary dataset format.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/dataset/format.hpp"
+#include "ml/model/format.hpp"
+#include "ml/types.hpp"
+
+namespace ml::dataset {
+/**
+ * @brief Encode a dataset header.
+ *
+ * @param[in] inputCount The number of input values per sample. Must exceed 0.
+ * @param[in] outputCount The number of output values per sample. Must exceed
+ *                        0.
+ * @param[in] scalarType The scalar type to store the values as.
+ * @param[out] header The encoded header.
+ *
+ * @return True if the header was encoded, or false on invalid parameters.
+ */
+bool encodeHeader(const size_t inputCount, const size_t outputCount,
+                  const ml::model::ScalarType scalarType,
+                  Header &header) noexcept;
+
+/**
+ * @brief Encode a sample, to be appended after the header.
+ *
+ * @param[in] input The input values of the sample.
+ * @param[in] output The output values of the sample.
+ * @param[in] scalarType The scalar type to store the values as, the same as
+ *                       in the header.
+ * @param[out] buffer The buffer to encode the sample into, aligned to the
+ *                    scalar size.
+ * @param[in] size The size of the buffer in bytes.
+ *
+ * @return The number of bytes written, sampleBytes(), or 0 on error.
+ */
+size_t encodeSample(const ml::Matrix1d &input, const ml::Matrix1d &output,
+                    const ml::model::ScalarType scalarType, void *buffer,
+                    const size_t size) noexcept;
+} // namespace ml::dataset
@@ -0,0 +1,267 @@
+/**
+ * @brief Binarized layer implementation details.
+ */
+#include <zephyr/sys/printk.h>
+
+#include "ml/dense_layer/binarized_layer.hpp"
+#include "ml/dense_layer/kernels.hpp"
+
+namespace ml::dense_layer {
+// -----------------------------------------------------------------------------
+BinarizedLayer::BinarizedLayer(Interface &shadowLayer,
+                               const ml::WeightLevels levels)
+    : myShadowLayer{shadowLayer}, myWeights{}, myScales{}, myOutput{},
+      myError{}, myBatchOutput{}, myBatchError{}, myWeightGradient{},
+      myBiasGradient{}, myBatchSize{}, myLevels{levels} {
+  const auto nodeCount{shadowLayer.nodeCount()};
+  const auto weightCount{shadowLayer.weightCount()};
+
+  if (!resizeZero(myWeights, nodeCount, weightCount) ||
+      !resizeZero(myScales, nodeCount) || !resizeZero(myOutput, nodeCount) ||
+      !resizeZero(myError, nodeCount) ||
+      !resizeZero(myWeightGradient, nodeCount, weightCount) ||
+      !resizeZero(myBiasGradient, nodeCount)) {
+    printk("failed to allocate binarized layer\n");
+    while (1) {
+    }
+  }
+  quantizeWeights();
+}
+
+// -----------------------------------------------------------------------------
+size_t BinarizedLayer::nodeCount() const noexcept {
+  return myShadowLayer.nodeCount();
+}
+
+// -----------------------------------------------------------------------------
+size_t BinarizedLayer::weightCount() const noexcept {
+  return myShadowLayer.weightCount();
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &BinarizedLayer::output() const noexcept {
+  return myOutput;
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &BinarizedLayer::error() const noexcept { return myError; }
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &BinarizedLayer::bias() const noexcept {
+  return myShadowLayer.bias();
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix2d &BinarizedLayer::weights() const noexcept {
+  return myWeights;
+}
+
+// -----------------------------------------------------------------------------
+ml::ActFunc BinarizedLayer::actFunc() const noexcept {
+  return myShadowLayer.actFunc();
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix2d &BinarizedLayer::batchOutput() const noexcept {
+  return myBatchOutput;
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix2d &BinarizedLayer::batchError() const noexcept {
+  return myBatchError;
+}
+
+// -----------------------------------------------------------------------------
+size_t BinarizedLayer::batchSize() const noexcept { return myBatchSize; }
+
+// -----------------------------------------------------------------------------
+bool BinarizedLayer::feedforward(const ml::Matrix1d &input) noexcept {
+  if (!checkInput(input)) {
+    return false;
+  }
+  forward(*this, input, myOutput);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool BinarizedLayer::backpropagate(const ml::Matrix1d &reference) noexcept {
+  if (reference.size() != nodeCount()) {
+    printk("output dimension mismatch: expected %u actual %u\n",
+           (unsigned)nodeCount(), (unsigned)reference.size());
+    return false;
+  }
+  outputError(*this, myOutput, reference, myError);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool BinarizedLayer::backpropagate(const Interface &nextLayer) noexcept {
+  if (nextLayer.weightCount() != nodeCount()) {
+    printk("layer dimension mismatch: expected %u actual %u\n",
+           (unsigned)nodeCount(), (unsigned)nextLayer.weightCount());
+    return false;
+  }
+  return hiddenError(*this, myOutput, nextLayer, nextLayer.error(), myError);
+}
+
+// -----------------------------------------------------------------------------
+bool BinarizedLayer::optimize(const ml::Matrix1d &input,
+                              const double learningRate) noexcept {
+  if (!checkInput(input)) {
+    return false;
+  }
+  // Straight-through: the gradient of the quantized weights is applied to
+  // the shadow weights as is.
+  setZero(myWeightGradient);
+  setZero(myBiasGradient);
+  accumulateGradient(myError, input, myWeightGradient, myBiasGradient);
+  return update(myWeightGradient, myBiasGradient, learningRate);
+}
+
+// -----------------------------------------------------------------------------
+bool BinarizedLayer::update(const ml::Matrix2d &weightGradient,
+                            const ml::Matrix1d &biasGradient,
+                            const double learningRate) noexcept {
+  if (!myShadowLayer.update(weightGradient, biasGradient, learningRate)) {
+    return false;
+  }
+  quantizeWeights();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool BinarizedLayer::feedforwardBatch(const ml::Matrix2d &batch,
+                                      const size_t batchSize) noexcept {
+  if ((0U == batchSize) || (batch.size() < batchSize)) {
+    printk("invalid batch size %u\n", (unsigned)batchSize);
+    return false;
+  }
+  for (size_t s{}; s < batchSize; ++s) {
+    if (!checkInput(batch[s])) {
+      return false;
+    }
+  }
+  if (!ensureBatch(batchSize)) {
+    return false;
+  }
+  myBatchSize = batchSize;
+
+  for (size_t s{}; s < batchSize; ++s) {
+    forward(*this, batch[s], myBatchOutput[s]);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool BinarizedLayer::backpropagateBatch(
+    const ml::Matrix2d &references) noexcept {
+  if (references.size() < myBatchSize) {
+    printk("invalid batch size %u\n", (unsigned)references.size());
+    return false;
+  }
+  for (size_t s{}; s < myBatchSize; ++s) {
+    if (references[s].size() != nodeCount()) {
+      printk("output dimension mismatch: expected %u actual %u\n",
+             (unsigned)nodeCount(), (unsigned)references[s].size());
+      return false;
+    }
+    outputError(*this, myBatchOutput[s], references[s], myBatchError[s]);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool BinarizedLayer::backpropagateBatch(const Interface &nextLayer) noexcept {
+  if (nextLayer.weightCount() != nodeCount()) {
+    printk("layer dimension mismatch: expected %u actual %u\n",
+           (unsigned)nodeCount(), (unsigned)nextLayer.weightCount());
+    return false;
+  }
+  if (nextLayer.batchSize() != myBatchSize) {
+    printk("batch size mismatch: expected %u actual %u\n",
+           (unsigned)myBatchSize, (unsigned)nextLayer.batchSize());
+    return false;
+  }
+  for (size_t s{}; s < myBatchSize; ++s) {
+    if (!hiddenError(*this, myBatchOutput[s], nextLayer,
+                     nextLayer.batchError()[s], myBatchError[s])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool BinarizedLayer::optimizeBatch(const ml::Matrix2d &batch,
+                                   const double learningRate) noexcept {
+  if ((0U == myBatchSize) || (batch.size() < myBatchSize)) {
+    printk("invalid batch size %u\n", (unsigned)batch.size());
+    return false;
+  }
+  setZero(myWeightGradient);
+  setZero(myBiasGradient);
+
+  for (size_t s{}; s < myBatchSize; ++s) {
+    if (!checkInput(batch[s])) {
+      return false;
+    }
+    accumulateGradient(myBatchError[s], batch[s], myWeightGradient,
+                       myBiasGradient);
+  }
+  // Apply one update with the mean gradient of the batch.
+  return update(myWeightGradient, myBiasGradient,
+                learningRate / static_cast<double>(myBatchSize));
+}
+
+// -----------------------------------------------------------------------------
+bool BinarizedLayer::setParameters(const ml::Matrix2d &weights,
+                                   const ml::Matrix1d &bias) noexcept {
+  if (!myShadowLayer.setParameters(weights, bias)) {
+    return false;
+  }
+  quantizeWeights();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool BinarizedLayer::resetOptimizer() noexcept { return true; }
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &BinarizedLayer::scales() const noexcept {
+  return myScales;
+}
+
+// -----------------------------------------------------------------------------
+ml::WeightLevels BinarizedLayer::levels() const noexcept { return myLevels; }
+
+// -----------------------------------------------------------------------------
+void BinarizedLayer::quantizeWeights() noexcept {
+  const auto &shadowWeights{myShadowLayer.weights()};
+
+  for (size_t i{}; i < myWeights.size(); ++i) {
+    myScales[i] = quantize(shadowWeights[i], myLevels, myWeights[i]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+bool BinarizedLayer::checkInput(const ml::Matrix1d &input) const noexcept {
+  if (input.size() != weightCount()) {
+    printk("input dimension mismatch: expected %u actual %u\n",
+           (unsigned)weightCount(), (unsigned)input.size());
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool BinarizedLayer::ensureBatch(const size_t batchSize) noexcept {
+  // Grow only, so a smaller last batch doesn't cause reallocations.
+  if ((myBatchOutput.size() < batchSize) &&
+      !(resizeZero(myBatchOutput, batchSize, nodeCount()) &&
+        resizeZero(myBatchError, batchSize, nodeCount()))) {
+    printk("failed to allocate batch buffers\n");
+    return false;
+  }
+  return true;
+}
+} // namespace ml::dense_layer
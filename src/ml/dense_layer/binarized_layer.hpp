@@ -0,0 +1,302 @@
+/**
+ * @brief Dense layer with binary or ternary weights for training.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/dense_layer/interface.hpp"
+#include "ml/types.hpp"
+
+namespace ml::dense_layer {
+/**
+ * @brief Dense layer with binary or ternary weights for training.
+ *
+ *        Wraps a layer holding real-valued shadow weights. Every forward and
+ *        backward pass uses the quantized weights, where each node has its
+ *        own scale:
+ *
+ *        binary:  w[i][j] = scale[i] * sign(shadow[i][j])
+ *        ternary: w[i][j] = scale[i] * sign(shadow[i][j]), or 0 if
+ *                 |shadow[i][j]| is small
+ *
+ *        Quantization has zero gradient almost everywhere, so updates use
+ *        the straight-through estimator: the gradient with respect to the
+ *        quantized weights is applied to the shadow weights unchanged, which
+ *        then get quantized again. Small updates accumulate in the shadow
+ *        weights until they flip a sign.
+ *
+ *        The optimizer attached to the shadow layer is used for updates.
+ *        Compile a trained layer with PackedWeightLayer for inference.
+ */
+class BinarizedLayer final : public Interface {
+public:
+  /**
+   * @brief Create a new binarized layer.
+   *
+   * @param[in] shadowLayer The layer holding the real-valued weights, must
+   *                        outlive the binarized layer.
+   * @param[in] levels The weight levels to use (default = binary).
+   */
+  explicit BinarizedLayer(Interface &shadowLayer,
+                          const ml::WeightLevels levels =
+                              ml::WeightLevels::Binary);
+
+  /**
+   * @brief Delete the binarized layer.
+   */
+  ~BinarizedLayer() noexcept override = default;
+
+  /**
+   * @brief Get the number of nodes in the layer.
+   *
+   * @return The number of nodes in the layer.
+   */
+  size_t nodeCount() const noexcept override;
+
+  /**
+   * @brief Get the number of weights per node in the layer.
+   *
+   * @return The number of weights per node in the layer.
+   */
+  size_t weightCount() const noexcept override;
+
+  /**
+   * @brief Get the output values of the layer.
+   *
+   * @return Vector holding the output values of the layer.
+   */
+  const ml::Matrix1d &output() const noexcept override;
+
+  /**
+   * @brief Get the error values of the layer.
+   *
+   * @return Vector holding the error values of the layer.
+   */
+  const ml::Matrix1d &error() const noexcept override;
+
+  /**
+   * @brief Get the bias values of the layer.
+   *
+   * @return Vector holding the bias values of the shadow layer.
+   */
+  const ml::Matrix1d &bias() const noexcept override;
+
+  /**
+   * @brief Get the quantized weights of the layer.
+   *
+   * @return Matrix holding the quantized weights, [node][weight].
+   */
+  const ml::Matrix2d &weights() const noexcept override;
+
+  /**
+   * @brief Get the activation function of the layer.
+   *
+   * @return The activation function used by the shadow layer.
+   */
+  ml::ActFunc actFunc() const noexcept override;
+
+  /**
+   * @brief Get the output values of the last batch.
+   *
+   * @return Matrix holding the output values, [sample][node]. Only the first
+   *         batchSize() rows are valid.
+   */
+  const ml::Matrix2d &batchOutput() const noexcept override;
+
+  /**
+   * @brief Get the error values of the last batch.
+   *
+   * @return Matrix holding the error values, [sample][node]. Only the first
+   *         batchSize() rows are valid.
+   */
+  const ml::Matrix2d &batchError() const noexcept override;
+
+  /**
+   * @brief Get the number of samples in the last batch.
+   *
+   * @return The number of samples passed to the last batch feedforward.
+   */
+  size_t batchSize() const noexcept override;
+
+  /**
+   * @brief Perform feedforward with the given input.
+   *
+   * @param[in] input Input values with which to perform feedforward.
+   *
+   * @return True if feedforward was performed, or false on error.
+   */
+  bool feedforward(const ml::Matrix1d &input) noexcept override;
+
+  /**
+   * @brief Perform backpropagation with the given reference values.
+   *
+   *        This method is appropriate for output layers only.
+   *
+   * @param[in] reference Reference values with which to perform
+   * backpropagation.
+   *
+   * @return True if backpropagation was performed, or false on error.
+   */
+  bool backpropagate(const ml::Matrix1d &reference) noexcept override;
+
+  /**
+   * @brief Perform backpropagation with the given next layer.
+   *
+   *        This method is appropriate for hidden layers only.
+   *
+   * @param[in] nextLayer The next consecutive layer.
+   *
+   * @return True if backpropagation was performed, or false on error.
+   */
+  bool backpropagate(const Interface &nextLayer) noexcept override;
+
+  /**
+   * @brief Perform optimization with the given input.
+   *
+   * @param[in] input Input values with which to perform optimization.
+   * @param[in] learningRate Learning rate to use for optimization.
+   *
+   * @return True if optimization was performed, or false on error.
+   */
+  bool optimize(const ml::Matrix1d &input,
+                const double learningRate) noexcept override;
+
+  /**
+   * @brief Update the shadow parameters with precomputed gradients.
+   *
+   *        The weights are quantized again afterwards.
+   *
+   * @param[in] weightGradient Weight gradients, [node][weight].
+   * @param[in] biasGradient Bias gradients, [node].
+   * @param[in] learningRate Learning rate to scale the gradients with.
+   *
+   * @return True if the parameters were updated, or false on error.
+   */
+  bool update(const ml::Matrix2d &weightGradient,
+              const ml::Matrix1d &biasGradient,
+              const double learningRate) noexcept override;
+
+  /**
+   * @brief Perform feedforward with a batch of inputs.
+   *
+   * @param[in] batch Input values, [sample][weight].
+   * @param[in] batchSize The number of rows of the batch to use. Must exceed 0.
+   *
+   * @return True if feedforward was performed, or false on error.
+   */
+  bool feedforwardBatch(const ml::Matrix2d &batch,
+                        const size_t batchSize) noexcept override;
+
+  /**
+   * @brief Perform backpropagation of the last batch with the given reference
+   *        values.
+   *
+   *        This method is appropriate for output layers only.
+   *
+   * @param[in] references Reference values, [sample][node].
+   *
+   * @return True if backpropagation was performed, or false on error.
+   */
+  bool backpropagateBatch(const ml::Matrix2d &references) noexcept override;
+
+  /**
+   * @brief Perform backpropagation of the last batch with the given next
+   *        layer.
+   *
+   *        This method is appropriate for hidden layers only.
+   *
+   * @param[in] nextLayer The next consecutive layer.
+   *
+   * @return True if backpropagation was performed, or false on error.
+   */
+  bool backpropagateBatch(const Interface &nextLayer) noexcept override;
+
+  /**
+   * @brief Perform optimization of the last batch with the given inputs.
+   *
+   * @param[in] batch Input values of the last batch, [sample][weight].
+   * @param[in] learningRate Learning rate to use for optimization.
+   *
+   * @return True if optimization was performed, or false on error.
+   */
+  bool optimizeBatch(const ml::Matrix2d &batch,
+                     const double learningRate) noexcept override;
+
+  /**
+   * @brief Overwrite the shadow parameters and quantize them.
+   *
+   * @param[in] weights The new real-valued weights, [node][weight].
+   * @param[in] bias The new bias values, [node].
+   *
+   * @return True if the parameters were set, or false on error.
+   */
+  bool setParameters(const ml::Matrix2d &weights,
+                     const ml::Matrix1d &bias) noexcept override;
+
+  /**
+   * @brief Reset the optimizer state, the layer has none.
+   *
+   * @return Always true.
+   */
+  bool resetOptimizer() noexcept override;
+
+  /**
+   * @brief Get the scale of each node.
+   *
+   * @return Vector holding the scale of each node.
+   */
+  const ml::Matrix1d &scales() const noexcept;
+
+  /**
+   * @brief Get the weight levels of the layer.
+   *
+   * @return The weight levels of the layer.
+   */
+  ml::WeightLevels levels() const noexcept;
+
+  BinarizedLayer() = delete;                                  // No default.
+  BinarizedLayer(const BinarizedLayer &) = delete;            // No copy.
+  BinarizedLayer(BinarizedLayer &&) = delete;                 // No move.
+  BinarizedLayer &operator=(const BinarizedLayer &) = delete; // No copy.
+  BinarizedLayer &operator=(BinarizedLayer &&) = delete;      // No move.
+
+private:
+  void quantizeWeights() noexcept;
+  bool checkInput(const ml::Matrix1d &input) const noexcept;
+  bool ensureBatch(const size_t batchSize) noexcept;
+
+  /** Reference to the layer holding the real-valued weights. */
+  Interface &myShadowLayer;
+
+  /** The quantized weights: [node][weight]. */
+  ml::Matrix2d myWeights;
+
+  /** The scale of each node. */
+  ml::Matrix1d myScales;
+
+  /** Vector holding the node outputs. */
+  ml::Matrix1d myOutput;
+
+  /** Vector holding the node errors. */
+  ml::Matrix1d myError;
+
+  /** Matrix holding the node outputs of the last batch: [sample][node]. */
+  ml::Matrix2d myBatchOutput;
+
+  /** Matrix holding the node errors of the last batch: [sample][node]. */
+  ml::Matrix2d myBatchError;
+
+  /** Accumulated weight gradients: [node][weight]. */
+  ml::Matrix2d myWeightGradient;
+
+  /** Accumulated bias gradients. */
+  ml::Matrix1d myBiasGradient;
+
+  /** The number of samples in the last batch. */
+  size_t myBatchSize;
+
+  /** The weight levels to quantize to. */
+  const ml::WeightLevels myLevels;
+};
+} // namespace ml::dense_layer
@@ -0,0 +1,154 @@
+/**
+ * @brief Binary input layer implementation details.
+ */
+#include <zephyr/sys/printk.h>
+
+#include "ml/dense_layer/binary_input_layer.hpp"
+#include "ml/dense_layer/kernels.hpp"
+
+namespace ml::dense_layer {
+// -----------------------------------------------------------------------------
+BinaryInputLayer::BinaryInputLayer(const Encoding encoding)
+    : myBase{}, myColumns{}, myWordSums{}, myOutput{}, myNodeCount{},
+      myWeightCount{}, myActFunc{ml::ActFunc::Relu}, myEncoding{encoding} {}
+
+// -----------------------------------------------------------------------------
+bool BinaryInputLayer::compile(const Interface &layer) noexcept {
+  const auto nodeCount{layer.nodeCount()};
+  const auto weightCount{layer.weightCount()};
+  const auto wordCount{ctr::BitVector::wordsFor(weightCount)};
+  const bool plusMinus{Encoding::PlusMinusOne == myEncoding};
+
+  myNodeCount = 0U;
+  myWeightCount = 0U;
+
+  if (!resizeZero(myBase, nodeCount) || !resizeZero(myOutput, nodeCount) ||
+      !resizeZero(myColumns, weightCount * nodeCount) ||
+      !resizeZero(myWordSums, wordCount * nodeCount)) {
+    printk("failed to allocate binary input layer\n");
+    return false;
+  }
+
+  for (size_t i{}; i < nodeCount; ++i) {
+    myBase[i] = layer.bias()[i];
+
+    for (size_t j{}; j < weightCount; ++j) {
+      const auto weight{layer.weights()[i][j]};
+
+      // -1/+1: sum = bias - sum(w) + 2 * sum(w of set bits).
+      if (plusMinus) {
+        myBase[i] -= weight;
+      }
+      const auto value{plusMinus ? 2.0 * weight : weight};
+      myColumns[j * nodeCount + i] = value;
+      myWordSums[(j / ctr::BitVector::WordBits) * nodeCount + i] += value;
+    }
+  }
+  myNodeCount = nodeCount;
+  myWeightCount = weightCount;
+  myActFunc = layer.actFunc();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool BinaryInputLayer::isCompiled() const noexcept { return 0U < myNodeCount; }
+
+// -----------------------------------------------------------------------------
+size_t BinaryInputLayer::nodeCount() const noexcept { return myNodeCount; }
+
+// -----------------------------------------------------------------------------
+size_t BinaryInputLayer::weightCount() const noexcept { return myWeightCount; }
+
+// -----------------------------------------------------------------------------
+BinaryInputLayer::Encoding BinaryInputLayer::encoding() const noexcept {
+  return myEncoding;
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &BinaryInputLayer::output() const noexcept {
+  return myOutput;
+}
+
+// -----------------------------------------------------------------------------
+bool BinaryInputLayer::pack(const ml::Matrix1d &input,
+                            ctr::BitVector &bits) const noexcept {
+  if (!isCompiled() || (input.size() != myWeightCount)) {
+    printk("binary input size mismatch: expected %u actual %u\n",
+           (unsigned)myWeightCount, (unsigned)input.size());
+    return false;
+  }
+  // Resizing clears the bits as well, but always reallocates.
+  if (bits.size() == myWeightCount) {
+    bits.reset();
+  } else if (!bits.resize(myWeightCount)) {
+    return false;
+  }
+  const double midpoint{Encoding::PlusMinusOne == myEncoding ? 0.0 : 0.5};
+
+  for (size_t j{}; j < myWeightCount; ++j) {
+    if (midpoint < input[j]) {
+      bits.set(j);
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool BinaryInputLayer::feedforward(const ctr::BitVector &input) noexcept {
+  using ctr::BitVector;
+
+  if (!isCompiled() || (input.size() != myWeightCount)) {
+    printk("binary input size mismatch: expected %u actual %u\n",
+           (unsigned)myWeightCount, (unsigned)input.size());
+    return false;
+  }
+  for (size_t i{}; i < myNodeCount; ++i) {
+    myOutput[i] = myBase[i];
+  }
+
+  for (size_t w{}; w < input.wordCount(); ++w) {
+    const auto first{w * BitVector::WordBits};
+    const auto bitCount{myWeightCount - first < BitVector::WordBits
+                            ? myWeightCount - first
+                            : BitVector::WordBits};
+    auto bits{input.word(w)};
+
+    // Dense words: add the word's sum and subtract the cleared bits instead.
+    if (2U * BitVector::popcount(bits) > bitCount) {
+      addColumn(&myWordSums[w * myNodeCount], 1.0);
+      bits = ~bits & (BitVector::WordBits == bitCount
+                          ? ~BitVector::Word{}
+                          : (BitVector::Word{1U} << bitCount) - 1U);
+
+      for (; 0U != bits; bits &= bits - 1U) {
+        addColumn(column(first + BitVector::lowestBit(bits)), -1.0);
+      }
+    } else {
+      for (; 0U != bits; bits &= bits - 1U) {
+        addColumn(column(first + BitVector::lowestBit(bits)), 1.0);
+      }
+    }
+  }
+
+  for (size_t i{}; i < myNodeCount; ++i) {
+    myOutput[i] = actFuncOutput(myActFunc, myOutput[i]);
+  }
+  if (ml::ActFunc::Softmax == myActFunc) {
+    softmax(myOutput, myNodeCount);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+const double *BinaryInputLayer::column(const size_t index) const noexcept {
+  return &myColumns[index * myNodeCount];
+}
+
+// -----------------------------------------------------------------------------
+void BinaryInputLayer::addColumn(const double *column,
+                                 const double sign) noexcept {
+  for (size_t i{}; i < myNodeCount; ++i) {
+    myOutput[i] += sign * column[i];
+  }
+}
+} // namespace ml::dense_layer
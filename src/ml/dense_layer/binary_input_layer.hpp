@@ -0,0 +1,155 @@
+/**
+ * @brief Dense layer inference on bit-packed binary inputs.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ctr/bit_vector.hpp"
+#include "ml/dense_layer/interface.hpp"
+#include "ml/types.hpp"
+
+namespace ml::dense_layer {
+/**
+ * @brief Dense layer inference on bit-packed binary inputs.
+ *
+ *        Inputs that are button or flag states only take two values, so
+ *        they're passed as one bit each instead of one double. The weights of
+ *        a trained layer are compiled into columns, one per input, and the
+ *        weighted sums only add the columns of the set bits:
+ *
+ *        sum[i] = base[i] + sum of column[j][i] for every set bit j
+ *
+ *        With 0/1 inputs the base is the bias. With -1/+1 inputs a set bit
+ *        is +1 and a cleared bit -1, which is folded in as base = bias -
+ *        sum(weights) and column = 2 * weight, so both encodings use the
+ *        same kernel.
+ *
+ *        The sum of all columns of each word is kept as well. When more than
+ *        half of the bits in a word are set, the popcount picks the cheaper
+ *        path: add the word's sum and subtract the columns of the cleared
+ *        bits. Each word therefore costs at most WordBits / 2 column adds.
+ *
+ *        The layer only reads the compiled parameters. Compile again after
+ *        the source layer changes.
+ */
+class BinaryInputLayer final {
+public:
+  /** Encodings of the binary inputs. */
+  enum class Encoding {
+    ZeroOne,      ///< A set bit is 1, a cleared bit is 0.
+    PlusMinusOne, ///< A set bit is +1, a cleared bit is -1.
+  };
+
+  /**
+   * @brief Create a new binary input layer.
+   *
+   * @param[in] encoding The encoding of the inputs (default = 0/1).
+   */
+  explicit BinaryInputLayer(const Encoding encoding = Encoding::ZeroOne);
+
+  /**
+   * @brief Delete the binary input layer.
+   */
+  ~BinaryInputLayer() noexcept = default;
+
+  /**
+   * @brief Compile the parameters of the given layer.
+   *
+   * @param[in] layer The trained layer to compile.
+   *
+   * @return True if the layer was compiled, or false on allocation failure.
+   */
+  bool compile(const Interface &layer) noexcept;
+
+  /**
+   * @brief Check whether a layer has been compiled.
+   *
+   * @return True if a layer has been compiled, or false if not.
+   */
+  bool isCompiled() const noexcept;
+
+  /**
+   * @brief Get the number of nodes in the layer.
+   *
+   * @return The number of nodes, 0 if nothing is compiled.
+   */
+  size_t nodeCount() const noexcept;
+
+  /**
+   * @brief Get the number of binary inputs of the layer.
+   *
+   * @return The number of inputs, 0 if nothing is compiled.
+   */
+  size_t weightCount() const noexcept;
+
+  /**
+   * @brief Get the encoding of the inputs.
+   *
+   * @return The encoding of the inputs.
+   */
+  Encoding encoding() const noexcept;
+
+  /**
+   * @brief Get the output values of the last feedforward.
+   *
+   * @return Vector holding the output values of the layer.
+   */
+  const ml::Matrix1d &output() const noexcept;
+
+  /**
+   * @brief Pack input values into bits.
+   *
+   *        Values above the midpoint of the encoding, 0.5 for 0/1 and 0 for
+   *        -1/+1, become set bits.
+   *
+   * @param[in] input Input values, must hold weightCount() values.
+   * @param[out] bits The packed inputs, resized if needed.
+   *
+   * @return True if the inputs were packed, or false on error.
+   */
+  bool pack(const ml::Matrix1d &input, ctr::BitVector &bits) const noexcept;
+
+  /**
+   * @brief Perform feedforward with the given packed input.
+   *
+   * @param[in] input Packed input bits, must hold weightCount() bits.
+   *
+   * @return True if feedforward was performed, or false on error.
+   */
+  bool feedforward(const ctr::BitVector &input) noexcept;
+
+  BinaryInputLayer(const BinaryInputLayer &) = delete;            // No copy.
+  BinaryInputLayer(BinaryInputLayer &&) = delete;                 // No move.
+  BinaryInputLayer &operator=(const BinaryInputLayer &) = delete; // No copy.
+  BinaryInputLayer &operator=(BinaryInputLayer &&) = delete;      // No move.
+
+private:
+  const double *column(const size_t index) const noexcept;
+  void addColumn(const double *column, const double sign) noexcept;
+
+  /** Weighted sums with no bits set, [node]. */
+  ml::Matrix1d myBase;
+
+  /** Column of each input, [input * node count + node]. */
+  ml::Matrix1d myColumns;
+
+  /** Sum of the columns of each word, [word * node count + node]. */
+  ml::Matrix1d myWordSums;
+
+  /** Vector holding the node outputs. */
+  ml::Matrix1d myOutput;
+
+  /** The number of nodes in the layer. */
+  size_t myNodeCount;
+
+  /** The number of binary inputs of the layer. */
+  size_t myWeightCount;
+
+  /** The activation function of the compiled layer. */
+  ml::ActFunc myActFunc;
+
+  /** The encoding of the inputs. */
+  const Encoding myEncoding;
+};
+} // namespace ml::dense_layer
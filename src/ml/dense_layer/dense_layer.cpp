@@ -3,106 +3,81 @@
  */
 #include <cstddef>
 #include <math.h>
-#include <stdlib.h>
 
 #include <zephyr/kernel.h>
 #include <zephyr/sys/printk.h>
 
 #include "ml/dense_layer/dense_layer.hpp"
+#include "ml/dense_layer/kernels.hpp"
+#include "ml/optimizer/interface.hpp"
+#include "ml/random/initializer.hpp"
 #include "ml/types.hpp"
 
 namespace ml::dense_layer {
 namespace {
-// -----------------------------------------------------------------------------
-void initRandom() noexcept {
-  // Static variable to track whether random generator has been seeded.
-  static bool initialized{false};
+/** The number of samples computed per weight row pass in batch kernels. */
+constexpr size_t BatchBlockSize{16U};
 
-  // Terminate the function if already initialized to avoid reseeding.
-  if (initialized) {
-    return;
-  }
+/** Weight of the history when the input range decays. */
+constexpr double InputRangeMomentum{0.999};
 
-  // Set up random numbers using the current time as a starting point.
-  srand((unsigned)k_cycle_get_32());
-
-  // Mark as initialized to prevent future reseeding.
-  initialized = true;
+// -----------------------------------------------------------------------------
+constexpr size_t min(const size_t x, const size_t y) noexcept {
+  return x <= y ? x : y;
 }
 
 // -----------------------------------------------------------------------------
-double randomStartVal() noexcept {
-  // Generate random weight initialization value in range [0.0, 1.0].
-  // Cast to double ensures floating-point division for precision.
-  return static_cast<double>(rand()) / RAND_MAX;
+double dot(const ml::Matrix1d &x, const ml::Matrix1d &y) noexcept {
+  double sum{};
+  for (size_t j{}; j < y.size(); ++j) {
+    sum += x[j] * y[j];
+  }
+  return sum;
 }
 
 // -----------------------------------------------------------------------------
-double actFuncOutput(const ml::ActFunc actFunc, const double input) noexcept {
-  // Compute activation function output for the given input value.
-  switch (actFunc) {
-  case ml::ActFunc::Relu:
-    // ReLU: f(x) = max(0, x) - return input if positive, zero otherwise.
-    return 0.0 < input ? input : 0.0;
-  case ml::ActFunc::Tanh:
-    // Hyperbolic tangent: f(x) = tanh(x) - output range [-1, 1].
-    return tanh(input);
-  default:
-    printk("invalid activation function\n");
-    return 0.0;
+double maxAbs(const ml::Matrix1d &values) noexcept {
+  double max{};
+  for (const auto value : values) {
+    max = fmax(max, fabs(value));
   }
+  return max;
 }
 
 // -----------------------------------------------------------------------------
-double actFuncDelta(const ml::ActFunc actFunc, const double input) noexcept {
-  // Calculate how much the activation function changes (needed for learning).
-  switch (actFunc) {
-  case ml::ActFunc::Relu:
-    // ReLU derivative: f'(x) = 1 if x > 0, else 0.
-    return 0.0 < input ? 1.0 : 0.0;
-  case ml::ActFunc::Tanh:
-    // Tanh derivative: f'(x) = 1 - tanh²(x).
-    return 1.0 - tanh(input) * tanh(input);
-  default:
-    printk("invalid activation function\n");
-    return 0.0;
+bool ensureRows(ml::Matrix2d &matrix, const size_t rowCount,
+                const size_t columnCount) noexcept {
+  // Grow only, so a smaller last batch doesn't cause reallocations.
+  if (matrix.size() >= rowCount) {
+    return true;
   }
+  return resizeZero(matrix, rowCount, columnCount);
 }
 } // namespace
 
 // -----------------------------------------------------------------------------
 DenseLayer::DenseLayer(const size_t nodeCount, const size_t weightCount,
                        const ml::ActFunc actFunc)
-    : myOutput{}, myError{}, myBias{}, myWeights{}, myActFunc{actFunc} {
-  // Make sure we have at least 1 node and 1 weight per node.
-  if ((0U == nodeCount) || (0U == weightCount)) {
-    printk("invalid dense layer parameters\n");
-    while (1) {
-    }
-  }
-
-  myOutput.resize(nodeCount);
-  myError.resize(nodeCount);
-  myBias.resize(nodeCount);
-  myWeights.resize(nodeCount);
-
-  // Initialize the random number generator (only done once).
-  initRandom();
-
-  // Initialize all biases and weights with random starting values.
-  for (size_t i{}; i < nodeCount; ++i) {
-
-    myOutput[i] = 0.0;
-    myError[i] = 0.0;
-    myBias[i] = randomStartVal();
-
-    ml::Matrix1d weights(weightCount);
-    myWeights[i] = weights;
+    : myOutput{}, myError{}, myBias{}, myWeights{}, myBatchOutput{},
+      myBatchError{}, myWeightGradient{}, myBiasGradient{}, myBatchSize{},
+      myOptimizer{nullptr}, myActive{}, myActiveCount{}, myQuantWeights{},
+      myWeightScales{}, myQuantInput{}, myInputRange{},
+      myQuantization{ml::Quantization::None}, myActFunc{actFunc} {
+  // Use the current time as a starting point, without any global state.
+  ml::random::Prng prng{k_cycle_get_32()};
+  init(nodeCount, weightCount, prng, ml::WeightInit::Default);
+}
 
-    for (size_t j{}; j < weightCount; ++j) {
-      myWeights[i][j] = randomStartVal();
-    }
-  }
+// -----------------------------------------------------------------------------
+DenseLayer::DenseLayer(const size_t nodeCount, const size_t weightCount,
+                       ml::random::Prng &prng, const ml::ActFunc actFunc,
+                       const ml::WeightInit init)
+    : myOutput{}, myError{}, myBias{}, myWeights{}, myBatchOutput{},
+      myBatchError{}, myWeightGradient{}, myBiasGradient{}, myBatchSize{},
+      myOptimizer{nullptr}, myActive{}, myActiveCount{}, myQuantWeights{},
+      myWeightScales{}, myQuantInput{}, myInputRange{},
+      myQuantization{ml::Quantization::None}, myActFunc{actFunc} {
+  this->init(nodeCount, weightCount, prng, init);
 }
 
 // -----------------------------------------------------------------------------
@@ -141,6 +116,30 @@ const ml::Matrix2d &DenseLayer::weights() const noexcept {
   return myWeights;
 }
 
+// -----------------------------------------------------------------------------
+ml::ActFunc DenseLayer::actFunc() const noexcept {
+  // Return the activation function used by this layer.
+  return myActFunc;
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix2d &DenseLayer::batchOutput() const noexcept {
+  // Return read-only access to the outputs of the last batch.
+  return myBatchOutput;
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix2d &DenseLayer::batchError() const noexcept {
+  // Return read-only access to the errors of the last batch.
+  return myBatchError;
+}
+
+// -----------------------------------------------------------------------------
+size_t DenseLayer::batchSize() const noexcept {
+  // Return the number of samples in the last batch.
+  return myBatchSize;
+}
+
 // -----------------------------------------------------------------------------
 bool DenseLayer::feedforward(const ml::Matrix1d &input) noexcept {
   // Validate that we have the correct number of inputs.
@@ -151,6 +150,11 @@ bool DenseLayer::feedforward(const ml::Matrix1d &input) noexcept {
     return false;
   }
 
+  // With fake quantization, both operands are rounded to integer levels.
+  const bool quantized{ml::Quantization::None != myQuantization};
+  const auto &values{quantized ? quantizeInput(input) : input};
+  const auto &weights{quantized ? myQuantWeights : myWeights};
+
   // Compute the output value for each node in this layer.
   for (size_t i{}; i < nodeCount(); ++i) {
     // Start with the bias (like a starting point for each node).
@@ -158,11 +162,16 @@ bool DenseLayer::feedforward(const ml::Matrix1d &input) noexcept {
 
     // Add up all the weighted inputs (input * weight for each connection).
     for (size_t j{}; j < weightCount(); ++j) {
-      sum += input[j] * myWeights[i][j];
+      sum += values[j] * weights[i][j];
     }
     // Pass the sum through the activation function to get the final output.
     myOutput[i] = actFuncOutput(myActFunc, sum);
   }
+  // Softmax normalizes the outputs of all nodes together.
+  if (ml::ActFunc::Softmax == myActFunc) {
+    softmax(myOutput, nodeCount());
+  }
+  updateActive();
   return true;
 }
 
@@ -195,9 +204,19 @@ bool DenseLayer::backpropagate(const Interface &nextLayer) noexcept {
            (unsigned)nodeCount(), (unsigned)nextLayer.weightCount());
     return false;
   }
+  // The softmax delta is only valid combined with the cross-entropy loss.
+  if (ml::ActFunc::Softmax == myActFunc) {
+    printk("softmax is only supported in the output layer\n");
+    return false;
+  }
+
+  // Inactive ReLU nodes have a zero derivative, so a zero error. Only the
+  // active nodes found by feedforward are computed.
+  setZero(myError);
 
   // Compute error gradients for each node (this is for hidden layers).
-  for (size_t i{}; i < nodeCount(); ++i) {
+  for (size_t a{}; a < myActiveCount; ++a) {
+    const size_t i{myActive[a]};
     double weightedErrorSum{};
 
     // Accumulate weighted error contributions from the next layer.
@@ -227,8 +246,31 @@ bool DenseLayer::optimize(const ml::Matrix1d &input,
     return false;
   }
 
-  // Update parameters using gradient descent to minimize error.
-  for (size_t i{}; i < nodeCount(); ++i) {
+  // With an optimizer attached or fake quantization, hand the gradient of
+  // this sample to update(). The gradient is taken at the quantized input,
+  // straight through the rounding.
+  if ((nullptr != myOptimizer) ||
+      (ml::Quantization::None != myQuantization)) {
+    const bool quantized{ml::Quantization::None != myQuantization};
+
+    if (!allocGradient()) {
+      return false;
+    }
+    setZero(myWeightGradient);
+    setZero(myBiasGradient);
+    accumulateGradient(myError, quantized ? myQuantInput : input,
+                       myWeightGradient, myBiasGradient);
+    if (quantized) {
+      updateInputRange(input);
+    }
+    return update(myWeightGradient, myBiasGradient, learningRate);
+  }
+
+  // Update parameters using gradient descent to minimize error. Inactive
+  // nodes have a zero error and are skipped.
+  for (size_t a{}; a < myActiveCount; ++a) {
+    const size_t i{myActive[a]};
+
     // Update bias: bias += error * learning_rate.
     myBias[i] += myError[i] * learningRate;
 
@@ -241,5 +283,466 @@ bool DenseLayer::optimize(const ml::Matrix1d &input,
   // Return true to indicate success.
   return true;
 }
+
+// -----------------------------------------------------------------------------
+bool DenseLayer::update(const ml::Matrix2d &weightGradient,
+                        const ml::Matrix1d &biasGradient,
+                        const double learningRate) noexcept {
+  // Validate learning rate and gradient dimensions.
+  if (0.0 >= learningRate) {
+    printk("invalid learning rate\n");
+    return false;
+  }
+  if ((weightGradient.size() != nodeCount()) ||
+      (biasGradient.size() != nodeCount())) {
+    printk("gradient dimension mismatch: expected %u actual %u\n",
+           (unsigned)nodeCount(), (unsigned)weightGradient.size());
+    return false;
+  }
+  for (const auto &nodeGradient : weightGradient) {
+    if (nodeGradient.size() != weightCount()) {
+      printk("gradient dimension mismatch: expected %u actual %u\n",
+             (unsigned)weightCount(), (unsigned)nodeGradient.size());
+      return false;
+    }
+  }
+
+  // Let the optimizer turn the gradients into updates, if one is attached.
+  if (nullptr != myOptimizer) {
+    if (!myOptimizer->update(myWeights, myBias, weightGradient, biasGradient,
+                             learningRate)) {
+      return false;
+    }
+  } else {
+    // Step every parameter along its precomputed gradient.
+    for (size_t i{}; i < nodeCount(); ++i) {
+      myBias[i] += biasGradient[i] * learningRate;
+
+      for (size_t j{}; j < weightCount(); ++j) {
+        myWeights[i][j] += weightGradient[i][j] * learningRate;
+      }
+    }
+  }
+  quantizeWeights();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool DenseLayer::feedforwardBatch(const ml::Matrix2d &batch,
+                                  const size_t batchSize) noexcept {
+  if (ml::Quantization::None != myQuantization) {
+    printk("batch training doesn't support fake quantization\n");
+    return false;
+  }
+  // Validate the batch size and the dimensions of the used rows.
+  if ((0U == batchSize) || (batch.size() < batchSize)) {
+    printk("invalid batch size %u\n", (unsigned)batchSize);
+    return false;
+  }
+  for (size_t s{}; s < batchSize; ++s) {
+    if (batch[s].size() != weightCount()) {
+      printk("input dimension mismatch: expected %u actual %u\n",
+             (unsigned)weightCount(), (unsigned)batch[s].size());
+      return false;
+    }
+  }
+  if (!ensureRows(myBatchOutput, batchSize, nodeCount()) ||
+      !ensureRows(myBatchError, batchSize, nodeCount())) {
+    printk("failed to allocate batch buffers\n");
+    return false;
+  }
+  myBatchSize = batchSize;
+
+  // Output = Input * Weights^T + Bias, computed one block of samples at a
+  // time so each weight row is reused while it's in cache.
+  for (size_t s0{}; s0 < batchSize; s0 += BatchBlockSize) {
+    const auto s1{min(s0 + BatchBlockSize, batchSize)};
+
+    for (size_t i{}; i < nodeCount(); ++i) {
+      const auto &nodeWeights{myWeights[i]};
+
+      for (size_t s{s0}; s < s1; ++s) {
+        const auto sum{myBias[i] + dot(batch[s], nodeWeights)};
+        myBatchOutput[s][i] = actFuncOutput(myActFunc, sum);
+      }
+    }
+  }
+  if (ml::ActFunc::Softmax == myActFunc) {
+    for (size_t s{}; s < batchSize; ++s) {
+      softmax(myBatchOutput[s], nodeCount());
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool DenseLayer::backpropagateBatch(const ml::Matrix2d &references) noexcept {
+  // Validate the reference dimensions against the last batch.
+  if (references.size() < myBatchSize) {
+    printk("invalid batch size %u\n", (unsigned)references.size());
+    return false;
+  }
+  for (size_t s{}; s < myBatchSize; ++s) {
+    if (references[s].size() != nodeCount()) {
+      printk("output dimension mismatch: expected %u actual %u\n",
+             (unsigned)nodeCount(), (unsigned)references[s].size());
+      return false;
+    }
+  }
+
+  // Compute the error gradients of each sample (this is for the output layer).
+  for (size_t s{}; s < myBatchSize; ++s) {
+    const auto &output{myBatchOutput[s]};
+    auto &error{myBatchError[s]};
+
+    for (size_t i{}; i < nodeCount(); ++i) {
+      error[i] =
+          (references[s][i] - output[i]) * actFuncDelta(myActFunc, output[i]);
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool DenseLayer::backpropagateBatch(const Interface &nextLayer) noexcept {
+  // Validate that the layers connect properly and hold the same batch.
+  if (nextLayer.weightCount() != nodeCount()) {
+    printk("layer dimension mismatch: expected %u actual %u\n",
+           (unsigned)nodeCount(), (unsigned)nextLayer.weightCount());
+    return false;
+  }
+  if (nextLayer.batchSize() != myBatchSize) {
+    printk("batch size mismatch: expected %u actual %u\n",
+           (unsigned)myBatchSize, (unsigned)nextLayer.batchSize());
+    return false;
+  }
+  if (ml::ActFunc::Softmax == myActFunc) {
+    printk("softmax is only supported in the output layer\n");
+    return false;
+  }
+  const auto &nextWeights{nextLayer.weights()};
+  const auto &nextErrors{nextLayer.batchError()};
+
+  // Error = NextError * NextWeights, accumulated row by row so both
+  // matrices are read contiguously.
+  for (size_t s{}; s < myBatchSize; ++s) {
+    const auto &nextError{nextErrors[s]};
+    auto &error{myBatchError[s]};
+    setZero(error);
+
+    for (size_t k{}; k < nextLayer.nodeCount(); ++k) {
+      const auto &nextNodeWeights{nextWeights[k]};
+
+      for (size_t i{}; i < nodeCount(); ++i) {
+        error[i] += nextError[k] * nextNodeWeights[i];
+      }
+    }
+    // Apply the chain rule with the activation function derivative.
+    for (size_t i{}; i < nodeCount(); ++i) {
+      error[i] *= actFuncDelta(myActFunc, myBatchOutput[s][i]);
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool DenseLayer::optimizeBatch(const ml::Matrix2d &batch,
+                               const double learningRate) noexcept {
+  // Validate learning rate and input dimensions against the last batch.
+  if (0.0 >= learningRate) {
+    printk("invalid learning rate\n");
+    return false;
+  }
+  if ((0U == myBatchSize) || (batch.size() < myBatchSize)) {
+    printk("invalid batch size %u\n", (unsigned)batch.size());
+    return false;
+  }
+  for (size_t s{}; s < myBatchSize; ++s) {
+    if (batch[s].size() != weightCount()) {
+      printk("input dimension mismatch: expected %u actual %u\n",
+             (unsigned)weightCount(), (unsigned)batch[s].size());
+      return false;
+    }
+  }
+
+  if (!allocGradient()) {
+    return false;
+  }
+  setZero(myWeightGradient);
+  setZero(myBiasGradient);
+
+  // Gradient = Error^T * Input, one block of samples at a time so each
+  // gradient row stays in cache while it's accumulated.
+  for (size_t s0{}; s0 < myBatchSize; s0 += BatchBlockSize) {
+    const auto s1{min(s0 + BatchBlockSize, myBatchSize)};
+
+    for (size_t i{}; i < nodeCount(); ++i) {
+      auto &nodeGradient{myWeightGradient[i]};
+
+      for (size_t s{s0}; s < s1; ++s) {
+        const auto error{myBatchError[s][i]};
+        const auto &input{batch[s]};
+        myBiasGradient[i] += error;
+
+        for (size_t j{}; j < weightCount(); ++j) {
+          nodeGradient[j] += error * input[j];
+        }
+      }
+    }
+  }
+
+  // Apply one update with the mean gradient of the batch.
+  return update(myWeightGradient, myBiasGradient,
+                learningRate / static_cast<double>(myBatchSize));
+}
+
+// -----------------------------------------------------------------------------
+bool DenseLayer::setParameters(const ml::Matrix2d &weights,
+                               const ml::Matrix1d &bias) noexcept {
+  // Validate the parameter dimensions before overwriting anything.
+  if ((weights.size() != nodeCount()) || (bias.size() != nodeCount())) {
+    printk("parameter dimension mismatch: expected %u actual %u\n",
+           (unsigned)nodeCount(), (unsigned)weights.size());
+    return false;
+  }
+  for (const auto &nodeWeights : weights) {
+    if (nodeWeights.size() != weightCount()) {
+      printk("parameter dimension mismatch: expected %u actual %u\n",
+             (unsigned)weightCount(), (unsigned)nodeWeights.size());
+      return false;
+    }
+  }
+
+  for (size_t i{}; i < nodeCount(); ++i) {
+    myBias[i] = bias[i];
+
+    for (size_t j{}; j < weightCount(); ++j) {
+      myWeights[i][j] = weights[i][j];
+    }
+  }
+  quantizeWeights();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool DenseLayer::reshape(const ml::Matrix2d &weights,
+                         const ml::Matrix1d &bias) noexcept {
+  const auto nodeCount{bias.size()};
+  const auto weightCount{weights.empty() ? 0U : weights[0].size()};
+
+  // Validate the parameter dimensions before overwriting anything.
+  if ((0U == nodeCount) || (0U == weightCount) ||
+      (weights.size() != nodeCount)) {
+    printk("invalid parameter dimensions: %u nodes, %u weights\n",
+           (unsigned)nodeCount, (unsigned)weightCount);
+    return false;
+  }
+  for (const auto &nodeWeights : weights) {
+    if (nodeWeights.size() != weightCount) {
+      printk("parameter dimension mismatch: expected %u actual %u\n",
+             (unsigned)weightCount, (unsigned)nodeWeights.size());
+      return false;
+    }
+  }
+  if (!resizeZero(myOutput, nodeCount) || !resizeZero(myError, nodeCount) ||
+      !resizeZero(myBias, nodeCount) ||
+      !resizeZero(myWeights, nodeCount, weightCount) ||
+      ((myActive.size() != nodeCount) && !myActive.resize(nodeCount))) {
+    printk("failed to allocate dense layer\n");
+    return false;
+  }
+  updateActive();
+  for (size_t i{}; i < nodeCount; ++i) {
+    myBias[i] = bias[i];
+
+    for (size_t j{}; j < weightCount; ++j) {
+      myWeights[i][j] = weights[i][j];
+    }
+  }
+
+  // The buffers are sized for the old shape, allocate them on next use.
+  myBatchOutput.clear();
+  myBatchError.clear();
+  myWeightGradient.clear();
+  myBiasGradient.clear();
+  myBatchSize = 0U;
+
+  if ((nullptr != myOptimizer) && !myOptimizer->init(nodeCount, weightCount)) {
+    printk("failed to allocate optimizer state\n");
+    return false;
+  }
+  // Size the fake quantization buffers for the new shape.
+  return setFakeQuant(myQuantization);
+}
+
+// -----------------------------------------------------------------------------
+bool DenseLayer::resetOptimizer() noexcept {
+  // Initializing the optimizer again zeroes its state for the same size.
+  return (nullptr == myOptimizer) ||
+         myOptimizer->init(nodeCount(), weightCount());
+}
+
+// -----------------------------------------------------------------------------
+bool DenseLayer::setOptimizer(ml::optimizer::Interface &optimizer) noexcept {
+  // Size the optimizer state for this layer before using it.
+  if (!optimizer.init(nodeCount(), weightCount())) {
+    printk("failed to allocate optimizer state\n");
+    return false;
+  }
+  myOptimizer = &optimizer;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool DenseLayer::setFakeQuant(const ml::Quantization quantization) noexcept {
+  myQuantization = ml::Quantization::None;
+  myInputRange = 0.0;
+
+  if (ml::Quantization::None == quantization) {
+    myQuantWeights.clear();
+    myWeightScales.clear();
+    myQuantInput.clear();
+    return true;
+  }
+  if (!resizeZero(myQuantWeights, nodeCount(), weightCount()) ||
+      !resizeZero(myWeightScales, nodeCount()) ||
+      !resizeZero(myQuantInput, weightCount())) {
+    printk("failed to allocate fake quantization buffers\n");
+    return false;
+  }
+  myQuantization = quantization;
+  quantizeWeights();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+void DenseLayer::calibrate(const ml::Matrix1d &input) noexcept {
+  myInputRange = fmax(myInputRange, maxAbs(input));
+}
+
+// -----------------------------------------------------------------------------
+ml::Quantization DenseLayer::quantization() const noexcept {
+  return myQuantization;
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &DenseLayer::weightScales() const noexcept {
+  return myWeightScales;
+}
+
+// -----------------------------------------------------------------------------
+double DenseLayer::inputScale() const noexcept {
+  const auto max{quantMax(myQuantization)};
+  return 0 < max ? myInputRange / max : 0.0;
+}
+
+// -----------------------------------------------------------------------------
+void DenseLayer::init(const size_t nodeCount, const size_t weightCount,
+                      ml::random::Prng &prng,
+                      const ml::WeightInit init) noexcept {
+  // Make sure we have at least 1 node and 1 weight per node.
+  if ((0U == nodeCount) || (0U == weightCount)) {
+    printk("invalid dense layer parameters\n");
+    while (1) {
+    }
+  }
+
+  myOutput.resize(nodeCount);
+  myError.resize(nodeCount);
+  myBias.resize(nodeCount);
+  myWeights.resize(nodeCount);
+  myActive.resize(nodeCount);
+
+  for (size_t i{}; i < nodeCount; ++i) {
+
+    myOutput[i] = 0.0;
+    myError[i] = 0.0;
+
+    ml::Matrix1d weights(weightCount);
+    myWeights[i] = weights;
+  }
+
+  // Initialize all weights with random starting values scaled to the layer
+  // size. ReLU biases start slightly positive, all others at zero.
+  ml::random::initialize(init, myActFunc, myWeights, myBias, prng);
+  updateActive();
+}
+
+// -----------------------------------------------------------------------------
+void DenseLayer::quantizeWeights() noexcept {
+  const auto max{quantMax(myQuantization)};
+
+  if (0 == max) {
+    return;
+  }
+  // Symmetric per-node scales, the largest weight maps to the largest level.
+  for (size_t i{}; i < nodeCount(); ++i) {
+    double largest{};
+
+    for (size_t j{}; j < weightCount(); ++j) {
+      largest = fmax(largest, fabs(myWeights[i][j]));
+    }
+    const auto scale{largest / max};
+    myWeightScales[i] = scale;
+
+    for (size_t j{}; j < weightCount(); ++j) {
+      myQuantWeights[i][j] = quantizeLevel(myWeights[i][j], scale, max) * scale;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &
+DenseLayer::quantizeInput(const ml::Matrix1d &input) noexcept {
+  const auto max{quantMax(myQuantization)};
+
+  // Without calibration, quantize to the range of the input itself. The
+  // calibrated range is never changed by predictions.
+  const auto range{0.0 < myInputRange ? myInputRange : maxAbs(input)};
+  const auto scale{0 < max ? range / max : 0.0};
+
+  for (size_t j{}; j < input.size(); ++j) {
+    myQuantInput[j] = quantizeLevel(input[j], scale, max) * scale;
+  }
+  return myQuantInput;
+}
+
+// -----------------------------------------------------------------------------
+void DenseLayer::updateInputRange(const ml::Matrix1d &input) noexcept {
+  // Follow a larger range at once so the largest inputs never clip, and
+  // let it decay slowly once those inputs are gone.
+  const auto observedRange{maxAbs(input)};
+
+  myInputRange = observedRange > myInputRange
+                     ? observedRange
+                     : InputRangeMomentum * myInputRange +
+                           (1.0 - InputRangeMomentum) * observedRange;
+}
+
+// -----------------------------------------------------------------------------
+void DenseLayer::updateActive() noexcept {
+  myActiveCount = 0U;
+
+  // ReLU nodes with a zero output have a zero derivative, all other nodes are
+  // active.
+  for (size_t i{}; i < nodeCount(); ++i) {
+    if ((ml::ActFunc::Relu != myActFunc) || (0.0 < myOutput[i])) {
+      myActive[myActiveCount++] = static_cast<uint32_t>(i);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+bool DenseLayer::allocGradient() noexcept {
+  // The gradient buffers are only needed for batch training and optimizers,
+  // allocate them on first use.
+  if ((myWeightGradient.size() != nodeCount()) &&
+      !(resizeZero(myWeightGradient, nodeCount(), weightCount()) &&
+        resizeZero(myBiasGradient, nodeCount()))) {
+    printk("failed to allocate gradient buffers\n");
+    return false;
+  }
+  return true;
+}
 } // namespace ml::dense_layer
 // namespace ml::denser
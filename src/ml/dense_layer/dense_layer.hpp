@@ -3,9 +3,13 @@
  */
 #pragma once
 
+#include <stdint.h>
+
 #include <zephyr/kernel.h>
 
 #include "ml/dense_layer/interface.hpp"
+#include "ml/optimizer/interface.hpp"
+#include "ml/random/prng.hpp"
 #include "ml/types.hpp"
 
 namespace ml::dense_layer {
@@ -17,6 +21,10 @@ public:
   /**
    * @brief Create a new dense layer.
    *
+   *        The weights are drawn from a generator seeded with the cycle
+   *        counter, so every run starts differently. Use the constructor
+   *        taking a generator for reproducible runs.
+   *
    * @param[in] nodeCount The number of nodes in the layer. Must exceed 0.
    * @param[in] weightCount The number of weights in the layer. Must exceed 0.
    * @param[in] actFunc The activation to use for this layer (default = ReLU).
@@ -24,6 +32,22 @@ public:
   explicit DenseLayer(const size_t nodeCount, const size_t weightCount,
                       const ml::ActFunc actFunc = ml::ActFunc::Relu);
 
+  /**
+   * @brief Create a new dense layer with weights drawn from the given
+   *        generator.
+   *
+   * @param[in] nodeCount The number of nodes in the layer. Must exceed 0.
+   * @param[in] weightCount The number of weights in the layer. Must exceed 0.
+   * @param[in, out] prng The generator to draw the initial weights from.
+   * @param[in] actFunc The activation to use for this layer (default = ReLU).
+   * @param[in] init The weight initializer to use (default = He normal for
+   *                 ReLU, Xavier normal otherwise).
+   */
+  explicit DenseLayer(const size_t nodeCount, const size_t weightCount,
+                      ml::random::Prng &prng,
+                      const ml::ActFunc actFunc = ml::ActFunc::Relu,
+                      const ml::WeightInit init = ml::WeightInit::Default);
+
   /**
    * @brief Delete the dense layer.
    */
@@ -71,6 +95,36 @@ public:
    */
   const ml::Matrix2d &weights() const noexcept override;
 
+  /**
+   * @brief Get the activation function of the dense layer.
+   *
+   * @return The activation function used by the dense layer.
+   */
+  ml::ActFunc actFunc() const noexcept override;
+
+  /**
+   * @brief Get the output values of the last batch.
+   *
+   * @return Matrix holding the output values, [sample][node]. Only the first
+   *         batchSize() rows are valid.
+   */
+  const ml::Matrix2d &batchOutput() const noexcept override;
+
+  /**
+   * @brief Get the error values of the last batch.
+   *
+   * @return Matrix holding the error values, [sample][node]. Only the first
+   *         batchSize() rows are valid.
+   */
+  const ml::Matrix2d &batchError() const noexcept override;
+
+  /**
+   * @brief Get the number of samples in the last batch.
+   *
+   * @return The number of samples passed to the last batch feedforward.
+   */
+  size_t batchSize() const noexcept override;
+
   /**
    * @brief Perform feedforward with the given input.
    *
@@ -114,6 +168,177 @@ public:
   bool optimize(const ml::Matrix1d &input,
                 const double learningRate) noexcept override;
 
+  /**
+   * @brief Update the parameters with precomputed gradients.
+   *
+   *        The gradients point in the descent direction, i.e. each parameter
+   *        is updated as parameter += learning_rate * gradient.
+   *
+   * @param[in] weightGradient Weight gradients, [node][weight].
+   * @param[in] biasGradient Bias gradients, [node].
+   * @param[in] learningRate Learning rate to scale the gradients with.
+   *
+   * @return True if the parameters were updated, or false on error.
+   */
+  bool update(const ml::Matrix2d &weightGradient,
+              const ml::Matrix1d &biasGradient,
+              const double learningRate) noexcept override;
+
+  /**
+   * @brief Perform feedforward with a batch of inputs.
+   *
+   *        The batch is computed as one matrix-matrix product, so each weight
+   *        row is reused for a block of samples while it is in cache.
+   *
+   * @param[in] batch Input values, [sample][weight].
+   * @param[in] batchSize The number of rows of the batch to use. Must exceed 0.
+   *
+   * @return True if feedforward was performed, or false on error.
+   */
+  bool feedforwardBatch(const ml::Matrix2d &batch,
+                        const size_t batchSize) noexcept override;
+
+  /**
+   * @brief Perform backpropagation of the last batch with the given reference
+   *        values.
+   *
+   *        This method is appropriate for output layers only.
+   *
+   * @param[in] references Reference values, [sample][node].
+   *
+   * @return True if backpropagation was performed, or false on error.
+   */
+  bool backpropagateBatch(const ml::Matrix2d &references) noexcept override;
+
+  /**
+   * @brief Perform backpropagation of the last batch with the given next
+   *        layer.
+   *
+   *        This method is appropriate for hidden layers only.
+   *
+   * @param[in] nextLayer The next consecutive layer.
+   *
+   * @return True if backpropagation was performed, or false on error.
+   */
+  bool backpropagateBatch(const Interface &nextLayer) noexcept override;
+
+  /**
+   * @brief Perform optimization of the last batch with the given inputs.
+   *
+   *        The gradients of all samples are accumulated in a separate buffer
+   *        and applied as one update with their mean.
+   *
+   * @param[in] batch Input values of the last batch, [sample][weight].
+   * @param[in] learningRate Learning rate to use for optimization.
+   *
+   * @return True if optimization was performed, or false on error.
+   */
+  bool optimizeBatch(const ml::Matrix2d &batch,
+                     const double learningRate) noexcept override;
+
+  /**
+   * @brief Overwrite the parameters of the dense layer.
+   *
+   * @param[in] weights The new weights, [node][weight].
+   * @param[in] bias The new bias values, [node].
+   *
+   * @return True if the parameters were set, or false on error.
+   */
+  bool setParameters(const ml::Matrix2d &weights,
+                     const ml::Matrix1d &bias) noexcept override;
+
+  /**
+   * @brief Reset the state of the attached optimizer, as if no update had
+   *        been made yet.
+   *
+   * @return True if the state was reset or no optimizer is attached, or
+   *         false on allocation failure.
+   */
+  bool resetOptimizer() noexcept override;
+
+  /**
+   * @brief Replace the parameters with ones of a different size.
+   *
+   *        The layer takes the node and weight counts of the new parameters,
+   *        e.g. to remove nodes after training. Batch and gradient buffers are
+   *        released and the state of an attached optimizer is reset.
+   *
+   * @param[in] weights The new weights, [node][weight]. Must not be the
+   *                    layer's own.
+   * @param[in] bias The new bias values, [node].
+   *
+   * @return True if the layer was reshaped, or false on error.
+   */
+  bool reshape(const ml::Matrix2d &weights, const ml::Matrix1d &bias) noexcept;
+
+  /**
+   * @brief Use the given optimizer for all subsequent updates.
+   *
+   *        The optimizer state is reset and sized for this layer. Without an
+   *        optimizer, plain gradient descent is used.
+   *
+   * @param[in] optimizer The optimizer to use, must outlive the layer and may
+   *                      not be shared with other layers.
+   *
+   * @return True if the optimizer was attached, or false on error.
+   */
+  bool setOptimizer(ml::optimizer::Interface &optimizer) noexcept;
+
+  /**
+   * @brief Simulate integer weights and inputs in feedforward and optimize.
+   *
+   *        Fake quantization rounds every weight to a level of its node's
+   *        scale, max(|weight|) / max level, and every input to a level of
+   *        the input scale, range / max level. Set the input range with
+   *        calibrate() before training or exporting. Training follows the
+   *        largest max(|input|) of the trained samples at once and decays
+   *        slowly when the inputs get smaller, predictions never change it.
+   *        The gradients pass the rounding straight through to the
+   *        full-precision weights, which weights() keeps returning.
+   *
+   *        Batch training isn't supported while fake quantization is on.
+   *
+   * @param[in] quantization The quantization to simulate, None to disable.
+   *
+   * @return True if the quantization was set, or false on allocation failure.
+   */
+  bool setFakeQuant(const ml::Quantization quantization) noexcept;
+
+  /**
+   * @brief Widen the fake quantization input range to cover the given input.
+   *
+   *        Call it for every input of the training set after setFakeQuant(),
+   *        the output layer with the hidden layer's outputs. Without
+   *        calibration, every input is quantized to its own range, and
+   *        ml::model::exportQuantizedHeader() rejects the layer.
+   *
+   * @param[in] input Input values of the layer.
+   */
+  void calibrate(const ml::Matrix1d &input) noexcept;
+
+  /**
+   * @brief Get the simulated quantization.
+   *
+   * @return The simulated quantization, None if disabled.
+   */
+  ml::Quantization quantization() const noexcept;
+
+  /**
+   * @brief Get the weight scale of each node.
+   *
+   * @return Vector holding the value of one weight level per node, empty if
+   *         fake quantization is disabled.
+   */
+  const ml::Matrix1d &weightScales() const noexcept;
+
+  /**
+   * @brief Get the input scale learned during training.
+   *
+   * @return The value of one input level, 0 if fake quantization is disabled
+   *         or no input was seen yet.
+   */
+  double inputScale() const noexcept;
+
   DenseLayer() = delete;                              // No default constructor.
   DenseLayer(const DenseLayer &) = delete;            // No copy constructor.
   DenseLayer(DenseLayer &&) = delete;                 // No move constructor.
@@ -121,6 +346,14 @@ public:
   DenseLayer &operator=(DenseLayer &&) = delete;      // No move assignment.
 
 private:
+  void init(const size_t nodeCount, const size_t weightCount,
+            ml::random::Prng &prng, const ml::WeightInit init) noexcept;
+  bool allocGradient() noexcept;
+  void quantizeWeights() noexcept;
+  const ml::Matrix1d &quantizeInput(const ml::Matrix1d &input) noexcept;
+  void updateInputRange(const ml::Matrix1d &input) noexcept;
+  void updateActive() noexcept;
+
   /** Vector holding the node outputs. */
   ml::Matrix1d myOutput;
 
@@ -134,6 +367,45 @@ private:
    * index. */
   ml::Matrix2d myWeights;
 
+  /** Matrix holding the node outputs of the last batch: [sample][node]. */
+  ml::Matrix2d myBatchOutput;
+
+  /** Matrix holding the node errors of the last batch: [sample][node]. */
+  ml::Matrix2d myBatchError;
+
+  /** Accumulated weight gradients of the last batch: [node][weight]. */
+  ml::Matrix2d myWeightGradient;
+
+  /** Accumulated bias gradients of the last batch. */
+  ml::Matrix1d myBiasGradient;
+
+  /** The number of samples in the last batch. */
+  size_t myBatchSize;
+
+  /** The optimizer to use for updates, plain gradient descent if null. */
+  ml::optimizer::Interface *myOptimizer;
+
+  /** Nodes with a non-zero derivative in the last feedforward, in order. */
+  ctr::Vector<uint32_t> myActive;
+
+  /** The number of active nodes. */
+  size_t myActiveCount;
+
+  /** Fake-quantized weights: [node][weight]. */
+  ml::Matrix2d myQuantWeights;
+
+  /** The value of one weight level per node. */
+  ml::Matrix1d myWeightScales;
+
+  /** Fake-quantized input of the last feedforward. */
+  ml::Matrix1d myQuantInput;
+
+  /** Input range of fake quantization, calibrated and followed in training. */
+  double myInputRange;
+
+  /** The simulated quantization. */
+  ml::Quantization myQuantization;
+
   /** The activation function to use in this layer. */
   const ml::ActFunc myActFunc;
 };
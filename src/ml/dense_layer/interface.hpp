@@ -58,6 +58,36 @@ public:
    */
   virtual const ml::Matrix2d &weights() const = 0;
 
+  /**
+   * @brief Get the activation function of the dense layer.
+   *
+   * @return The activation function used by the dense layer.
+   */
+  virtual ml::ActFunc actFunc() const = 0;
+
+  /**
+   * @brief Get the output values of the last batch.
+   *
+   * @return Matrix holding the output values, [sample][node]. Only the first
+   *         batchSize() rows are valid.
+   */
+  virtual const ml::Matrix2d &batchOutput() const = 0;
+
+  /**
+   * @brief Get the error values of the last batch.
+   *
+   * @return Matrix holding the error values, [sample][node]. Only the first
+   *         batchSize() rows are valid.
+   */
+  virtual const ml::Matrix2d &batchError() const = 0;
+
+  /**
+   * @brief Get the number of samples in the last batch.
+   *
+   * @return The number of samples passed to the last batch feedforward.
+   */
+  virtual size_t batchSize() const = 0;
+
   /**
    * @brief Perform feedforward with the given input.
    *
@@ -100,5 +130,92 @@ public:
    */
   virtual bool optimize(const ml::Matrix1d &input,
                         const double learningRate) = 0;
+
+  /**
+   * @brief Update the parameters with precomputed gradients.
+   *
+   *        The gradients point in the descent direction, i.e. each parameter
+   *        is updated as parameter += learning_rate * gradient.
+   *
+   * @param[in] weightGradient Weight gradients, [node][weight].
+   * @param[in] biasGradient Bias gradients, [node].
+   * @param[in] learningRate Learning rate to scale the gradients with.
+   *
+   * @return True if the parameters were updated, or false on error.
+   */
+  virtual bool update(const ml::Matrix2d &weightGradient,
+                      const ml::Matrix1d &biasGradient,
+                      const double learningRate) = 0;
+
+  /**
+   * @brief Perform feedforward with a batch of inputs.
+   *
+   *        The batch is computed as one matrix-matrix product, so each weight
+   *        row is reused for a block of samples while it is in cache.
+   *
+   * @param[in] batch Input values, [sample][weight].
+   * @param[in] batchSize The number of rows of the batch to use. Must exceed 0.
+   *
+   * @return True if feedforward was performed, or false on error.
+   */
+  virtual bool feedforwardBatch(const ml::Matrix2d &batch,
+                                const size_t batchSize) = 0;
+
+  /**
+   * @brief Perform backpropagation of the last batch with the given reference
+   *        values.
+   *
+   *        This method is appropriate for output layers only.
+   *
+   * @param[in] references Reference values, [sample][node].
+   *
+   * @return True if backpropagation was performed, or false on error.
+   */
+  virtual bool backpropagateBatch(const ml::Matrix2d &references) = 0;
+
+  /**
+   * @brief Perform backpropagation of the last batch with the given next
+   *        layer.
+   *
+   *        This method is appropriate for hidden layers only.
+   *
+   * @param[in] nextLayer The next consecutive layer.
+   *
+   * @return True if backpropagation was performed, or false on error.
+   */
+  virtual bool backpropagateBatch(const Interface &nextLayer) = 0;
+
+  /**
+   * @brief Perform optimization of the last batch with the given inputs.
+   *
+   *        The gradients of all samples are accumulated in a separate buffer
+   *        and applied as one update with their mean.
+   *
+   * @param[in] batch Input values of the last batch, [sample][weight].
+   * @param[in] learningRate Learning rate to use for optimization.
+   *
+   * @return True if optimization was performed, or false on error.
+   */
+  virtual bool optimizeBatch(const ml::Matrix2d &batch,
+                             const double learningRate) = 0;
+
+  /**
+   * @brief Overwrite the parameters of the dense layer.
+   *
+   * @param[in] weights The new weights, [node][weight].
+   * @param[in] bias The new bias values, [node].
+   *
+   * @return True if the parameters were set, or false on error.
+   */
+  virtual bool setParameters(const ml::Matrix2d &weights,
+                             const ml::Matrix1d &bias) = 0;
+
+  /**
+   * @brief Reset the state of the attached optimizer, as if no update had
+   *        been made yet.
+   *
+   * @return True if the state was reset or there is none, or false on error.
+   */
+  virtual bool resetOptimizer() = 0;
 };
 } // namespace ml::dense_layer
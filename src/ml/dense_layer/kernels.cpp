@@ -0,0 +1,301 @@
+/**
+ * @brief Stateless dense layer kernel implementation details.
+ */
+#include <math.h>
+
+#include <zephyr/sys/printk.h>
+
+#include "ml/dense_layer/kernels.hpp"
+
+namespace ml::dense_layer {
+namespace {
+/** Largest error of a correct prediction without softmax. */
+constexpr double Tolerance{1e-1};
+
+/** Smallest probability in the cross-entropy loss, keeps log() finite. */
+constexpr double MinProbability{1e-12};
+} // namespace
+
+// -----------------------------------------------------------------------------
+double actFuncOutput(const ml::ActFunc actFunc, const double input) noexcept {
+  // Compute activation function output for the given input value.
+  switch (actFunc) {
+  case ml::ActFunc::Relu:
+    // ReLU: f(x) = max(0, x) - return input if positive, zero otherwise.
+    return 0.0 < input ? input : 0.0;
+  case ml::ActFunc::Tanh:
+    // Hyperbolic tangent: f(x) = tanh(x) - output range [-1, 1].
+    return tanh(input);
+  case ml::ActFunc::Softmax:
+    // Softmax: normalized over the whole layer by softmax().
+    return input;
+  default:
+    printk("invalid activation function\n");
+    return 0.0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+double actFuncDelta(const ml::ActFunc actFunc, const double input) noexcept {
+  // Calculate how much the activation function changes (needed for learning).
+  switch (actFunc) {
+  case ml::ActFunc::Relu:
+    // ReLU derivative: f'(x) = 1 if x > 0, else 0.
+    return 0.0 < input ? 1.0 : 0.0;
+  case ml::ActFunc::Tanh:
+    // Tanh derivative: f'(x) = 1 - tanh²(x).
+    return 1.0 - tanh(input) * tanh(input);
+  case ml::ActFunc::Softmax:
+    // Softmax with cross-entropy: the error is already the gradient.
+    return 1.0;
+  default:
+    printk("invalid activation function\n");
+    return 0.0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+void softmax(double *values, const size_t count) noexcept {
+  if (0U == count) {
+    return;
+  }
+  auto max{values[0U]};
+  double sum{};
+
+  for (size_t i{1U}; i < count; ++i) {
+    max = fmax(max, values[i]);
+  }
+  for (size_t i{}; i < count; ++i) {
+    values[i] = exp(values[i] - max);
+    sum += values[i];
+  }
+  // The largest value became 1, so the sum is at least 1.
+  for (size_t i{}; i < count; ++i) {
+    values[i] /= sum;
+  }
+}
+
+// -----------------------------------------------------------------------------
+void softmax(ml::Matrix1d &values, const size_t count) noexcept {
+  if ((0U < count) && (count <= values.size())) {
+    softmax(&values[0U], count);
+  }
+}
+
+// -----------------------------------------------------------------------------
+size_t argmax(const double *values, const size_t count) noexcept {
+  size_t index{};
+
+  for (size_t i{1U}; i < count; ++i) {
+    if (values[i] > values[index]) {
+      index = i;
+    }
+  }
+  return index;
+}
+
+// -----------------------------------------------------------------------------
+size_t argmax(const ml::Matrix1d &values) noexcept {
+  return values.empty() ? 0U : argmax(values.data(), values.size());
+}
+
+// -----------------------------------------------------------------------------
+bool resizeZero(ml::Matrix1d &vector, const size_t size) noexcept {
+  // Only reallocate when the size changes, the allocator always copies.
+  if ((vector.size() != size) && !vector.resize(size)) {
+    return false;
+  }
+  setZero(vector);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool resizeZero(ml::Matrix2d &matrix, const size_t rowCount,
+                const size_t columnCount) noexcept {
+  if ((matrix.size() != rowCount) && !matrix.resize(rowCount)) {
+    return false;
+  }
+  for (auto &row : matrix) {
+    if (!resizeZero(row, columnCount)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+void setZero(ml::Matrix1d &vector) noexcept {
+  for (auto &value : vector) {
+    value = 0.0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+void setZero(ml::Matrix2d &matrix) noexcept {
+  for (auto &row : matrix) {
+    setZero(row);
+  }
+}
+
+// -----------------------------------------------------------------------------
+void forward(const Interface &layer, const ml::Matrix1d &input,
+             ml::Matrix1d &output) noexcept {
+  // Fetch the parameters once, the accessors are virtual.
+  const auto &weights{layer.weights()};
+  const auto &bias{layer.bias()};
+  const auto actFunc{layer.actFunc()};
+
+  for (size_t i{}; i < bias.size(); ++i) {
+    // Start with the bias and add up all the weighted inputs.
+    const auto &nodeWeights{weights[i]};
+    auto sum{bias[i]};
+
+    for (size_t j{}; j < nodeWeights.size(); ++j) {
+      sum += input[j] * nodeWeights[j];
+    }
+    output[i] = actFuncOutput(actFunc, sum);
+  }
+  if (ml::ActFunc::Softmax == actFunc) {
+    softmax(output, bias.size());
+  }
+}
+
+// -----------------------------------------------------------------------------
+void outputError(const Interface &layer, const ml::Matrix1d &output,
+                 const ml::Matrix1d &reference, ml::Matrix1d &error) noexcept {
+  const auto actFunc{layer.actFunc()};
+
+  for (size_t i{}; i < output.size(); ++i) {
+    // Prediction error scaled by the activation function derivative.
+    error[i] = (reference[i] - output[i]) * actFuncDelta(actFunc, output[i]);
+  }
+}
+
+// -----------------------------------------------------------------------------
+bool hiddenError(const Interface &layer, const ml::Matrix1d &output,
+                 const Interface &nextLayer, const ml::Matrix1d &nextError,
+                 ml::Matrix1d &error) noexcept {
+  const auto &nextWeights{nextLayer.weights()};
+  const auto actFunc{layer.actFunc()};
+
+  if (ml::ActFunc::Softmax == actFunc) {
+    printk("softmax is only supported in the output layer\n");
+    return false;
+  }
+
+  for (size_t i{}; i < output.size(); ++i) {
+    double weightedErrorSum{};
+
+    // Each connection propagates the next layer's error back through its
+    // weight.
+    for (size_t j{}; j < nextError.size(); ++j) {
+      weightedErrorSum += nextError[j] * nextWeights[j][i];
+    }
+    error[i] = weightedErrorSum * actFuncDelta(actFunc, output[i]);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+double sampleLoss(const Interface &layer, const ml::Matrix1d &output,
+                  const ml::Matrix1d &reference) noexcept {
+  double sum{};
+
+  if (ml::ActFunc::Softmax == layer.actFunc()) {
+    // Cross-entropy between the predicted and the reference distribution.
+    for (size_t i{}; i < output.size(); ++i) {
+      sum -= reference[i] * log(fmax(output[i], MinProbability));
+    }
+    return sum;
+  }
+  for (size_t i{}; i < output.size(); ++i) {
+    const auto difference{reference[i] - output[i]};
+    sum += difference * difference;
+  }
+  return 0.5 * sum;
+}
+
+// -----------------------------------------------------------------------------
+bool isCorrect(const Interface &layer, const ml::Matrix1d &output,
+               const ml::Matrix1d &reference) noexcept {
+  return ml::ActFunc::Softmax == layer.actFunc()
+             ? argmax(output) == argmax(reference)
+             : fabs(output[0] - reference[0]) <= Tolerance;
+}
+
+// -----------------------------------------------------------------------------
+void accumulateGradient(const ml::Matrix1d &error, const ml::Matrix1d &input,
+                        ml::Matrix2d &weightGradient,
+                        ml::Matrix1d &biasGradient) noexcept {
+  for (size_t i{}; i < error.size(); ++i) {
+    auto &nodeGradient{weightGradient[i]};
+    biasGradient[i] += error[i];
+
+    for (size_t j{}; j < input.size(); ++j) {
+      nodeGradient[j] += error[i] * input[j];
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+double quantize(const ml::Matrix1d &weights, const ml::WeightLevels levels,
+                ml::Matrix1d &quantized) noexcept {
+  const auto count{weights.size()};
+  double magnitude{};
+
+  for (size_t j{}; j < count; ++j) {
+    magnitude += fabs(weights[j]);
+  }
+  // Ternary weights below the threshold are dropped, binary ones never.
+  const auto threshold{ml::WeightLevels::Ternary == levels
+                           ? 0.7 * magnitude / static_cast<double>(count)
+                           : -1.0};
+  double keptMagnitude{};
+  size_t keptCount{};
+
+  for (size_t j{}; j < count; ++j) {
+    if (fabs(weights[j]) > threshold) {
+      keptMagnitude += fabs(weights[j]);
+      ++keptCount;
+    }
+  }
+  const auto scale{0U < keptCount
+                       ? keptMagnitude / static_cast<double>(keptCount)
+                       : 0.0};
+
+  for (size_t j{}; j < count; ++j) {
+    if (fabs(weights[j]) <= threshold) {
+      quantized[j] = 0.0;
+    } else {
+      quantized[j] = 0.0 <= weights[j] ? scale : -scale;
+    }
+  }
+  return scale;
+}
+
+// -----------------------------------------------------------------------------
+int32_t quantMax(const ml::Quantization quantization) noexcept {
+  switch (quantization) {
+  case ml::Quantization::Int8:
+    return 127;
+  case ml::Quantization::Int4:
+    return 7;
+  default:
+    return 0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+int32_t quantizeLevel(const double value, const double scale,
+                      const int32_t max) noexcept {
+  if (0.0 >= scale) {
+    return 0;
+  }
+  // Clamp before converting, large values don't fit the integer.
+  const auto level{round(value / scale)};
+  if (level >= max) {
+    return max;
+  }
+  return level <= -max ? -max : static_cast<int32_t>(level);
+}
+} // namespace ml::dense_layer
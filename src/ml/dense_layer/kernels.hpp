@@ -0,0 +1,248 @@
+/**
+ * @brief Stateless dense layer kernels.
+ *
+ *        The kernels only read the parameters of a layer and write their
+ *        results into caller-owned buffers, which makes it possible for
+ *        several threads to run them against the same layer at once.
+ */
+#pragma once
+
+#include <stdint.h>
+
+#include "ml/dense_layer/interface.hpp"
+#include "ml/types.hpp"
+
+namespace ml::dense_layer {
+/**
+ * @brief Compute the output of the given activation function.
+ *
+ *        Softmax depends on all nodes of the layer, so it passes the input
+ *        through and the layer applies softmax() to its outputs afterwards.
+ *
+ * @param[in] actFunc The activation function to use.
+ * @param[in] input The input value of the activation function.
+ *
+ * @return The output of the activation function.
+ */
+double actFuncOutput(const ml::ActFunc actFunc, const double input) noexcept;
+
+/**
+ * @brief Compute the derivative of the given activation function.
+ *
+ *        Softmax output layers are trained with the cross-entropy loss. The
+ *        gradient of both combined is reference - output, so its derivative
+ *        is 1.
+ *
+ * @param[in] actFunc The activation function to use.
+ * @param[in] input The input value of the activation function.
+ *
+ * @return The derivative of the activation function.
+ */
+double actFuncDelta(const ml::ActFunc actFunc, const double input) noexcept;
+
+/**
+ * @brief Turn the given values into probabilities summing up to 1.
+ *
+ *        values[i] = exp(values[i] - max) / sum(exp(values[j] - max)),
+ *        shifting by the largest value keeps exp() from overflowing.
+ *
+ * @param[in, out] values The values to normalize.
+ * @param[in] count The number of values to normalize, the first ones.
+ */
+void softmax(double *values, const size_t count) noexcept;
+
+/**
+ * @brief Turn the first values of a vector into probabilities summing up to
+ *        1, see softmax() above.
+ *
+ * @param[in, out] values The values to normalize.
+ * @param[in] count The number of values to normalize, at most values.size().
+ */
+void softmax(ml::Matrix1d &values, const size_t count) noexcept;
+
+/**
+ * @brief Get the index of the largest value.
+ *
+ * @param[in] values The values to search, the first of equal values wins.
+ * @param[in] count The number of values to search.
+ *
+ * @return The index of the largest value, 0 if there are no values.
+ */
+size_t argmax(const double *values, const size_t count) noexcept;
+
+/**
+ * @brief Get the index of the largest value of a vector, see argmax() above.
+ *
+ * @param[in] values The values to search, the first of equal values wins.
+ *
+ * @return The index of the largest value, 0 for an empty vector.
+ */
+size_t argmax(const ml::Matrix1d &values) noexcept;
+
+/**
+ * @brief Resize a vector and set all its values to zero.
+ *
+ * @param[in, out] vector The vector to resize.
+ * @param[in] size The new size of the vector.
+ *
+ * @return True if the vector was resized, or false on allocation failure.
+ */
+bool resizeZero(ml::Matrix1d &vector, const size_t size) noexcept;
+
+/**
+ * @brief Resize a matrix and set all its values to zero.
+ *
+ * @param[in, out] matrix The matrix to resize.
+ * @param[in] rowCount The new number of rows of the matrix.
+ * @param[in] columnCount The new number of columns of the matrix.
+ *
+ * @return True if the matrix was resized, or false on allocation failure.
+ */
+bool resizeZero(ml::Matrix2d &matrix, const size_t rowCount,
+                const size_t columnCount) noexcept;
+
+/**
+ * @brief Set all values of a vector to zero.
+ *
+ * @param[in, out] vector The vector to clear.
+ */
+void setZero(ml::Matrix1d &vector) noexcept;
+
+/**
+ * @brief Set all values of a matrix to zero.
+ *
+ * @param[in, out] matrix The matrix to clear.
+ */
+void setZero(ml::Matrix2d &matrix) noexcept;
+
+/**
+ * @brief Compute the output of a layer for the given input.
+ *
+ * @param[in] layer The layer holding the parameters to use.
+ * @param[in] input Input values, must hold weightCount() values.
+ * @param[out] output Output values, must hold nodeCount() values.
+ */
+void forward(const Interface &layer, const ml::Matrix1d &input,
+             ml::Matrix1d &output) noexcept;
+
+/**
+ * @brief Compute the errors of an output layer for the given reference.
+ *
+ * @param[in] layer The output layer.
+ * @param[in] output Output values of the layer, computed by forward().
+ * @param[in] reference Reference values, must hold nodeCount() values.
+ * @param[out] error Error values, must hold nodeCount() values.
+ */
+void outputError(const Interface &layer, const ml::Matrix1d &output,
+                 const ml::Matrix1d &reference, ml::Matrix1d &error) noexcept;
+
+/**
+ * @brief Compute the errors of a hidden layer from the next layer's errors.
+ *
+ *        Softmax is only supported in the output layer, where its error
+ *        combines with the cross-entropy loss. A hidden softmax layer would
+ *        need the full Jacobian and is rejected.
+ *
+ * @param[in] layer The hidden layer.
+ * @param[in] output Output values of the layer, computed by forward().
+ * @param[in] nextLayer The next consecutive layer.
+ * @param[in] nextError Error values of the next layer.
+ * @param[out] error Error values, must hold nodeCount() values.
+ *
+ * @return True on success, or False if the layer uses softmax.
+ */
+bool hiddenError(const Interface &layer, const ml::Matrix1d &output,
+                 const Interface &nextLayer, const ml::Matrix1d &nextError,
+                 ml::Matrix1d &error) noexcept;
+
+/**
+ * @brief Compute the training loss of one sample.
+ *
+ *        Softmax outputs use the cross-entropy loss, all others half the
+ *        squared error. outputError() returns the negated gradient of this
+ *        loss.
+ *
+ * @param[in] layer The output layer.
+ * @param[in] output Output values of the layer, computed by forward().
+ * @param[in] reference Reference values, must hold nodeCount() values.
+ *
+ * @return The loss of the sample.
+ */
+double sampleLoss(const Interface &layer, const ml::Matrix1d &output,
+                  const ml::Matrix1d &reference) noexcept;
+
+/**
+ * @brief Check whether the prediction of one sample is correct.
+ *
+ *        Softmax outputs are correct if the predicted class matches the
+ *        reference class, all others if the first output is within 0.1 of
+ *        its reference.
+ *
+ * @param[in] layer The output layer.
+ * @param[in] output Output values of the layer, computed by forward().
+ * @param[in] reference Reference values, must hold nodeCount() values.
+ *
+ * @return True if the prediction is correct, otherwise False.
+ */
+bool isCorrect(const Interface &layer, const ml::Matrix1d &output,
+               const ml::Matrix1d &reference) noexcept;
+
+/**
+ * @brief Add the gradient of one sample to the given gradient buffers.
+ *
+ *        The gradient points in the descent direction, i.e. it is applied as
+ *        weight += learning_rate * gradient.
+ *
+ * @param[in] error Error values of the layer for the sample.
+ * @param[in] input Input values of the layer for the sample.
+ * @param[in, out] weightGradient Weight gradients, [node][weight].
+ * @param[in, out] biasGradient Bias gradients, [node].
+ */
+void accumulateGradient(const ml::Matrix1d &error, const ml::Matrix1d &input,
+                        ml::Matrix2d &weightGradient,
+                        ml::Matrix1d &biasGradient) noexcept;
+
+/**
+ * @brief Quantize the weights of one node to binary or ternary levels.
+ *
+ *        Binary weights become +-scale with scale = mean(|w|). Ternary weights
+ *        below 0.7 * mean(|w|) become 0, the others +-scale with scale =
+ *        mean(|w|) of the kept weights. Both scales minimize the squared
+ *        quantization error for the chosen signs, and quantizing quantized
+ *        weights again gives the same result.
+ *
+ * @param[in] weights The weights of the node.
+ * @param[in] levels The levels to quantize to.
+ * @param[out] quantized The quantized weights, must hold as many values as
+ *                       the weights.
+ *
+ * @return The scale of the quantized weights.
+ */
+double quantize(const ml::Matrix1d &weights, const ml::WeightLevels levels,
+                ml::Matrix1d &quantized) noexcept;
+
+/**
+ * @brief Get the largest integer level of the given quantization.
+ *
+ * @param[in] quantization The quantization to use.
+ *
+ * @return The largest level, the levels are symmetric around 0. 0 for full
+ *         precision.
+ */
+int32_t quantMax(const ml::Quantization quantization) noexcept;
+
+/**
+ * @brief Quantize a value to an integer level.
+ *
+ *        The value is divided by the scale, rounded to the nearest level and
+ *        clamped to [-max, max].
+ *
+ * @param[in] value The value to quantize.
+ * @param[in] scale The value of one level, 0 maps everything to level 0.
+ * @param[in] max The largest level.
+ *
+ * @return The integer level of the value.
+ */
+int32_t quantizeLevel(const double value, const double scale,
+                      const int32_t max) noexcept;
+} // namespace ml::dense_layer
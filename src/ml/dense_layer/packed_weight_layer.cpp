@@ -0,0 +1,181 @@
+/**
+ * @brief Packed weight layer implementation details.
+ */
+#include <zephyr/sys/printk.h>
+
+#include "ml/dense_layer/kernels.hpp"
+#include "ml/dense_layer/packed_weight_layer.hpp"
+
+namespace ml::dense_layer {
+namespace {
+// -----------------------------------------------------------------------------
+bool resizeWords(ctr::Vector<ctr::BitVector::Word> &words,
+                 const size_t size) noexcept {
+  if ((words.size() != size) && !words.resize(size)) {
+    return false;
+  }
+  for (size_t i{}; i < size; ++i) {
+    words[i] = 0U;
+  }
+  return true;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+PackedWeightLayer::PackedWeightLayer(const ml::WeightLevels levels)
+    : mySigns{}, myMasks{}, myScales{}, myBias{}, myOutput{}, myNodeCount{},
+      myWeightCount{}, myWordCount{}, myActFunc{ml::ActFunc::Relu},
+      myLevels{levels} {}
+
+// -----------------------------------------------------------------------------
+bool PackedWeightLayer::compile(const Interface &layer) noexcept {
+  using ctr::BitVector;
+  const auto nodeCount{layer.nodeCount()};
+  const auto weightCount{layer.weightCount()};
+  const auto wordCount{BitVector::wordsFor(weightCount)};
+  const bool ternary{ml::WeightLevels::Ternary == myLevels};
+  ml::Matrix1d quantized{};
+
+  myNodeCount = 0U;
+
+  if (!resizeWords(mySigns, nodeCount * wordCount) ||
+      (ternary && !resizeWords(myMasks, nodeCount * wordCount)) ||
+      !resizeZero(myScales, nodeCount) || !resizeZero(myBias, nodeCount) ||
+      !resizeZero(myOutput, nodeCount) || !resizeZero(quantized, weightCount)) {
+    printk("failed to allocate packed weight layer\n");
+    return false;
+  }
+
+  for (size_t i{}; i < nodeCount; ++i) {
+    myScales[i] = quantize(layer.weights()[i], myLevels, quantized);
+    myBias[i] = layer.bias()[i];
+
+    for (size_t j{}; j < weightCount; ++j) {
+      const auto index{i * wordCount + j / BitVector::WordBits};
+      const BitVector::Word bit{BitVector::Word{1U}
+                                << (j % BitVector::WordBits)};
+
+      if (0.0 < quantized[j]) {
+        mySigns[index] |= bit;
+      }
+      if (ternary && (0.0 != quantized[j])) {
+        myMasks[index] |= bit;
+      }
+    }
+  }
+  myNodeCount = nodeCount;
+  myWeightCount = weightCount;
+  myWordCount = wordCount;
+  myActFunc = layer.actFunc();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool PackedWeightLayer::isCompiled() const noexcept { return 0U < myNodeCount; }
+
+// -----------------------------------------------------------------------------
+size_t PackedWeightLayer::nodeCount() const noexcept { return myNodeCount; }
+
+// -----------------------------------------------------------------------------
+size_t PackedWeightLayer::weightCount() const noexcept {
+  return myWeightCount;
+}
+
+// -----------------------------------------------------------------------------
+size_t PackedWeightLayer::parameterBytes() const noexcept {
+  return (mySigns.size() + myMasks.size()) * sizeof(Word) +
+         (myScales.size() + myBias.size()) * sizeof(double);
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &PackedWeightLayer::output() const noexcept {
+  return myOutput;
+}
+
+// -----------------------------------------------------------------------------
+bool PackedWeightLayer::feedforward(const ml::Matrix1d &input) noexcept {
+  using ctr::BitVector;
+
+  if (!isCompiled() || (input.size() != myWeightCount)) {
+    printk("input dimension mismatch: expected %u actual %u\n",
+           (unsigned)myWeightCount, (unsigned)input.size());
+    return false;
+  }
+
+  for (size_t i{}; i < myNodeCount; ++i) {
+    double sum{};
+
+    // Add the inputs of positive weights, subtract those of negative ones.
+    for (size_t w{}; w < myWordCount; ++w) {
+      const auto first{w * BitVector::WordBits};
+      const auto signs{mySigns[i * myWordCount + w]};
+      const auto valid{mask(i, w)};
+
+      for (auto bits{signs & valid}; 0U != bits; bits &= bits - 1U) {
+        sum += input[first + BitVector::lowestBit(bits)];
+      }
+      for (auto bits{~signs & valid}; 0U != bits; bits &= bits - 1U) {
+        sum -= input[first + BitVector::lowestBit(bits)];
+      }
+    }
+    myOutput[i] = actFuncOutput(myActFunc, myBias[i] + myScales[i] * sum);
+  }
+  if (ml::ActFunc::Softmax == myActFunc) {
+    softmax(myOutput, myNodeCount);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool PackedWeightLayer::feedforward(
+    const ctr::BitVector &input,
+    const BinaryInputLayer::Encoding encoding) noexcept {
+  using ctr::BitVector;
+  const bool plusMinus{BinaryInputLayer::Encoding::PlusMinusOne == encoding};
+
+  if (!isCompiled() || (input.size() != myWeightCount)) {
+    printk("input dimension mismatch: expected %u actual %u\n",
+           (unsigned)myWeightCount, (unsigned)input.size());
+    return false;
+  }
+
+  for (size_t i{}; i < myNodeCount; ++i) {
+    int dot{};
+
+    for (size_t w{}; w < myWordCount; ++w) {
+      const auto x{input.word(w)};
+      const auto signs{mySigns[i * myWordCount + w]};
+      const auto valid{mask(i, w)};
+      const auto validCount{static_cast<int>(BitVector::popcount(valid))};
+
+      if (plusMinus) {
+        // XNOR counts matching signs, each match is +1, each mismatch -1.
+        const auto matches{BitVector::popcount(~(x ^ signs) & valid)};
+        dot += 2 * static_cast<int>(matches) - validCount;
+      } else {
+        dot += static_cast<int>(BitVector::popcount(x & signs & valid)) -
+               static_cast<int>(BitVector::popcount(x & ~signs & valid));
+      }
+    }
+    myOutput[i] = actFuncOutput(myActFunc, myBias[i] + myScales[i] * dot);
+  }
+  if (ml::ActFunc::Softmax == myActFunc) {
+    softmax(myOutput, myNodeCount);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+PackedWeightLayer::Word
+PackedWeightLayer::mask(const size_t node, const size_t word) const noexcept {
+  using ctr::BitVector;
+
+  if (ml::WeightLevels::Ternary == myLevels) {
+    return myMasks[node * myWordCount + word];
+  }
+  // Binary weights are all non-zero, only the bits past the end are unused.
+  const auto bitCount{myWeightCount - word * BitVector::WordBits};
+  return bitCount >= BitVector::WordBits ? ~Word{}
+                                         : (Word{1U} << bitCount) - 1U;
+}
+} // namespace ml::dense_layer
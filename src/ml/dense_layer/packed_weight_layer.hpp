@@ -0,0 +1,154 @@
+/**
+ * @brief Dense layer inference with bit-packed binary or ternary weights.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ctr/bit_vector.hpp"
+#include "ctr/vector.hpp"
+#include "ml/dense_layer/binary_input_layer.hpp"
+#include "ml/dense_layer/interface.hpp"
+#include "ml/types.hpp"
+
+namespace ml::dense_layer {
+/**
+ * @brief Dense layer inference with bit-packed binary or ternary weights.
+ *
+ *        Each weight is stored as a sign bit, ternary weights have a second
+ *        bit marking the non-zero ones, and every node keeps a real-valued
+ *        scale. That's 1 or 2 bits per weight instead of 64.
+ *
+ *        Real-valued inputs are added or subtracted according to the sign
+ *        bits, so the only multiply per node is the scale. Bit-packed inputs
+ *        use word-wide logic instead, per word of 32 inputs:
+ *
+ *        0/1 inputs:  popcount(x & plus) - popcount(x & minus)
+ *        -1/+1 inputs: 2 * popcount(~(x ^ sign) & mask) - popcount(mask)
+ *
+ *        where the second form is the XNOR-popcount dot product.
+ *
+ *        Layers are compiled from a trained layer, usually a BinarizedLayer.
+ *        Other layers are quantized the same way while compiling.
+ */
+class PackedWeightLayer final {
+public:
+  /** The type of the words holding the weight bits. */
+  using Word = ctr::BitVector::Word;
+
+  /**
+   * @brief Create a new packed weight layer.
+   *
+   * @param[in] levels The weight levels to use (default = binary).
+   */
+  explicit PackedWeightLayer(
+      const ml::WeightLevels levels = ml::WeightLevels::Binary);
+
+  /**
+   * @brief Delete the packed weight layer.
+   */
+  ~PackedWeightLayer() noexcept = default;
+
+  /**
+   * @brief Compile the parameters of the given layer.
+   *
+   * @param[in] layer The trained layer to compile.
+   *
+   * @return True if the layer was compiled, or false on allocation failure.
+   */
+  bool compile(const Interface &layer) noexcept;
+
+  /**
+   * @brief Check whether a layer has been compiled.
+   *
+   * @return True if a layer has been compiled, or false if not.
+   */
+  bool isCompiled() const noexcept;
+
+  /**
+   * @brief Get the number of nodes in the layer.
+   *
+   * @return The number of nodes, 0 if nothing is compiled.
+   */
+  size_t nodeCount() const noexcept;
+
+  /**
+   * @brief Get the number of weights per node in the layer.
+   *
+   * @return The number of weights per node, 0 if nothing is compiled.
+   */
+  size_t weightCount() const noexcept;
+
+  /**
+   * @brief Get the size of the compiled parameters.
+   *
+   * @return The number of bytes of weight bits, scales and bias values.
+   */
+  size_t parameterBytes() const noexcept;
+
+  /**
+   * @brief Get the output values of the last feedforward.
+   *
+   * @return Vector holding the output values of the layer.
+   */
+  const ml::Matrix1d &output() const noexcept;
+
+  /**
+   * @brief Perform feedforward with the given input.
+   *
+   * @param[in] input Input values, must hold weightCount() values.
+   *
+   * @return True if feedforward was performed, or false on error.
+   */
+  bool feedforward(const ml::Matrix1d &input) noexcept;
+
+  /**
+   * @brief Perform feedforward with the given packed input.
+   *
+   * @param[in] input Packed input bits, must hold weightCount() bits.
+   * @param[in] encoding The encoding of the input bits.
+   *
+   * @return True if feedforward was performed, or false on error.
+   */
+  bool feedforward(const ctr::BitVector &input,
+                   const BinaryInputLayer::Encoding encoding) noexcept;
+
+  PackedWeightLayer(const PackedWeightLayer &) = delete;            // No copy.
+  PackedWeightLayer(PackedWeightLayer &&) = delete;                 // No move.
+  PackedWeightLayer &operator=(const PackedWeightLayer &) = delete; // No copy.
+  PackedWeightLayer &operator=(PackedWeightLayer &&) = delete;      // No move.
+
+private:
+  Word mask(const size_t node, const size_t word) const noexcept;
+
+  /** Sign bits, set for positive weights: [node * words per row + word]. */
+  ctr::Vector<Word> mySigns;
+
+  /** Non-zero bits of ternary weights, same layout as the signs. */
+  ctr::Vector<Word> myMasks;
+
+  /** The scale of each node. */
+  ml::Matrix1d myScales;
+
+  /** Vector holding the node bias values. */
+  ml::Matrix1d myBias;
+
+  /** Vector holding the node outputs. */
+  ml::Matrix1d myOutput;
+
+  /** The number of nodes in the layer. */
+  size_t myNodeCount;
+
+  /** The number of weights per node. */
+  size_t myWeightCount;
+
+  /** The number of words per node. */
+  size_t myWordCount;
+
+  /** The activation function of the compiled layer. */
+  ml::ActFunc myActFunc;
+
+  /** The weight levels to quantize to. */
+  const ml::WeightLevels myLevels;
+};
+} // namespace ml::dense_layer
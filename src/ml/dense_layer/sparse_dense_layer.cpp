@@ -0,0 +1,117 @@
+/**
+ * @brief Sparse dense layer implementation details.
+ */
+#include <zephyr/sys/printk.h>
+
+#include "ml/dense_layer/kernels.hpp"
+#include "ml/dense_layer/sparse_dense_layer.hpp"
+
+namespace ml::dense_layer {
+// -----------------------------------------------------------------------------
+SparseDenseLayer::SparseDenseLayer() noexcept
+    : myRowStart{}, myColumns{}, myValues{}, myBias{}, myOutput{},
+      myWeightCount{}, myActFunc{ml::ActFunc::Relu} {}
+
+// -----------------------------------------------------------------------------
+bool SparseDenseLayer::compile(const Interface &layer) noexcept {
+  constexpr size_t maxWeightCount{UINT16_MAX + 1U};
+  const auto nodeCount{layer.nodeCount()};
+  const auto weightCount{layer.weightCount()};
+  const auto &weights{layer.weights()};
+
+  myRowStart.clear();
+  myWeightCount = 0U;
+
+  if (maxWeightCount < weightCount) {
+    printk("too many weights for sparse layer: %u\n", (unsigned)weightCount);
+    return false;
+  }
+
+  // Count first, so every buffer is allocated exactly once.
+  size_t count{};
+  for (size_t i{}; i < nodeCount; ++i) {
+    for (size_t j{}; j < weightCount; ++j) {
+      count += 0.0 != weights[i][j] ? 1U : 0U;
+    }
+  }
+  // Keep one value even for a fully pruned layer, empty vectors don't
+  // allocate.
+  const auto valueCount{0U < count ? count : 1U};
+
+  if (!myRowStart.resize(nodeCount + 1U) ||
+      ((myColumns.size() != valueCount) && !myColumns.resize(valueCount)) ||
+      !resizeZero(myValues, valueCount) || !resizeZero(myBias, nodeCount) ||
+      !resizeZero(myOutput, nodeCount)) {
+    printk("failed to allocate sparse layer\n");
+    myRowStart.clear();
+    return false;
+  }
+
+  size_t index{};
+  for (size_t i{}; i < nodeCount; ++i) {
+    myRowStart[i] = static_cast<uint32_t>(index);
+    myBias[i] = layer.bias()[i];
+
+    for (size_t j{}; j < weightCount; ++j) {
+      if (0.0 != weights[i][j]) {
+        myColumns[index] = static_cast<uint16_t>(j);
+        myValues[index++] = weights[i][j];
+      }
+    }
+  }
+  myRowStart[nodeCount] = static_cast<uint32_t>(index);
+  myWeightCount = weightCount;
+  myActFunc = layer.actFunc();
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool SparseDenseLayer::isCompiled() const noexcept {
+  return !myRowStart.empty();
+}
+
+// -----------------------------------------------------------------------------
+size_t SparseDenseLayer::nodeCount() const noexcept { return myBias.size(); }
+
+// -----------------------------------------------------------------------------
+size_t SparseDenseLayer::weightCount() const noexcept { return myWeightCount; }
+
+// -----------------------------------------------------------------------------
+size_t SparseDenseLayer::nonZeroCount() const noexcept {
+  return isCompiled() ? myRowStart[nodeCount()] : 0U;
+}
+
+// -----------------------------------------------------------------------------
+size_t SparseDenseLayer::parameterBytes() const noexcept {
+  return nonZeroCount() * (sizeof(double) + sizeof(uint16_t)) +
+         myRowStart.size() * sizeof(uint32_t) + myBias.size() * sizeof(double);
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &SparseDenseLayer::output() const noexcept {
+  return myOutput;
+}
+
+// -----------------------------------------------------------------------------
+bool SparseDenseLayer::feedforward(const ml::Matrix1d &input) noexcept {
+  if (!isCompiled() || (input.size() != myWeightCount)) {
+    printk("input dimension mismatch: expected %u actual %u\n",
+           (unsigned)myWeightCount, (unsigned)input.size());
+    return false;
+  }
+
+  for (size_t i{}; i < nodeCount(); ++i) {
+    auto sum{myBias[i]};
+
+    // Only the stored weights contribute, pruned ones are skipped.
+    for (size_t k{myRowStart[i]}; k < myRowStart[i + 1U]; ++k) {
+      sum += myValues[k] * input[myColumns[k]];
+    }
+    myOutput[i] = actFuncOutput(myActFunc, sum);
+  }
+  if (ml::ActFunc::Softmax == myActFunc) {
+    softmax(myOutput, nodeCount());
+  }
+  return true;
+}
+} // namespace ml::dense_layer
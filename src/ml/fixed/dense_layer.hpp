@@ -0,0 +1,216 @@
+/**
+ * @brief Dense layer with compile-time dimensions.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/fixed/math.hpp"
+#include "ml/random/prng.hpp"
+#include "ml/types.hpp"
+
+namespace ml::fixed {
+/**
+ * @brief Compute the output of the given activation function.
+ *
+ * @param[in] actFunc The activation function to use.
+ * @param[in] input The input value of the activation function.
+ *
+ * @return The output of the activation function.
+ */
+constexpr double actFuncOutput(const ml::ActFunc actFunc,
+                               const double input) noexcept {
+  return ml::ActFunc::Tanh == actFunc ? tanh(input)
+                                      : (0.0 < input ? input : 0.0);
+}
+
+/**
+ * @brief Compute the derivative of the given activation function.
+ *
+ *        Like the runtime layer, the derivative is evaluated at the output.
+ *
+ * @param[in] actFunc The activation function to use.
+ * @param[in] input The input value of the activation function.
+ *
+ * @return The derivative of the activation function.
+ */
+constexpr double actFuncDelta(const ml::ActFunc actFunc,
+                              const double input) noexcept {
+  if (ml::ActFunc::Tanh == actFunc) {
+    const auto output{tanh(input)};
+    return 1.0 - output * output;
+  }
+  return 0.0 < input ? 1.0 : 0.0;
+}
+
+/**
+ * @brief Dense layer with compile-time dimensions.
+ *
+ *        Mirrors ml::dense_layer::DenseLayer with fixed-size arrays instead of
+ *        heap vectors, so every operation can run in a constant expression.
+ *
+ * @tparam NodeCount The number of nodes in the layer.
+ * @tparam WeightCount The number of weights per node in the layer.
+ */
+template <size_t NodeCount, size_t WeightCount> class DenseLayer final {
+public:
+  static_assert(0U < NodeCount, "a layer needs at least one node");
+  static_assert(0U < WeightCount, "a node needs at least one weight");
+
+  /**
+   * @brief Create a new dense layer.
+   *
+   *        The weights are drawn uniformly with He scaling for ReLU and
+   *        Xavier scaling otherwise, ReLU biases start at 0.1 (see
+   *        ml/random/initializer.hpp).
+   *
+   * @param[in, out] prng The generator to draw the initial weights from.
+   * @param[in] actFunc The activation to use for this layer (default = ReLU).
+   */
+  explicit constexpr DenseLayer(ml::random::Prng &prng,
+                                const ml::ActFunc actFunc = ml::ActFunc::Relu)
+      : myOutput{}, myError{}, myBias{}, myWeights{}, myActFunc{actFunc} {
+    const auto variance{ml::ActFunc::Relu == actFunc
+                            ? 2.0 / WeightCount
+                            : 2.0 / (WeightCount + NodeCount)};
+    const auto limit{sqrt(3.0 * variance)};
+
+    for (size_t i{}; i < NodeCount; ++i) {
+      myBias[i] = ml::ActFunc::Relu == actFunc ? 0.1 : 0.0;
+
+      for (size_t j{}; j < WeightCount; ++j) {
+        myWeights[i][j] = prng.uniform(-limit, limit);
+      }
+    }
+  }
+
+  /**
+   * @brief Get the output values of the dense layer.
+   *
+   * @return Array holding the output values of the dense layer.
+   */
+  constexpr const double (&output() const noexcept)[NodeCount] {
+    return myOutput;
+  }
+
+  /**
+   * @brief Get the bias values of the dense layer.
+   *
+   * @return Array holding the bias values of the dense layer.
+   */
+  constexpr const double (&bias() const noexcept)[NodeCount] { return myBias; }
+
+  /**
+   * @brief Get the weights of the dense layer.
+   *
+   * @return Array holding the weights of the dense layer, [node][weight].
+   */
+  constexpr const double (&weights() const noexcept)[NodeCount][WeightCount] {
+    return myWeights;
+  }
+
+  /**
+   * @brief Get the activation function of the dense layer.
+   *
+   * @return The activation function used by the dense layer.
+   */
+  constexpr ml::ActFunc actFunc() const noexcept { return myActFunc; }
+
+  /**
+   * @brief Compute the output for the given input without storing it.
+   *
+   * @param[in] input Input values.
+   * @param[out] output Output values.
+   */
+  constexpr void compute(const double (&input)[WeightCount],
+                         double (&output)[NodeCount]) const noexcept {
+    for (size_t i{}; i < NodeCount; ++i) {
+      // Start with the bias and add up all the weighted inputs.
+      auto sum{myBias[i]};
+
+      for (size_t j{}; j < WeightCount; ++j) {
+        sum += input[j] * myWeights[i][j];
+      }
+      output[i] = actFuncOutput(myActFunc, sum);
+    }
+  }
+
+  /**
+   * @brief Perform feedforward with the given input.
+   *
+   * @param[in] input Input values.
+   */
+  constexpr void feedforward(const double (&input)[WeightCount]) noexcept {
+    compute(input, myOutput);
+  }
+
+  /**
+   * @brief Perform backpropagation with the given reference values.
+   *
+   *        This method is appropriate for output layers only.
+   *
+   * @param[in] reference Reference values holding the expected output.
+   */
+  constexpr void backpropagate(const double (&reference)[NodeCount]) noexcept {
+    for (size_t i{}; i < NodeCount; ++i) {
+      myError[i] = (reference[i] - myOutput[i]) *
+                   actFuncDelta(myActFunc, myOutput[i]);
+    }
+  }
+
+  /**
+   * @brief Perform backpropagation with the given next layer.
+   *
+   *        This method is appropriate for hidden layers only.
+   *
+   * @param[in] nextLayer The next consecutive layer.
+   */
+  template <size_t NextNodeCount>
+  constexpr void backpropagate(
+      const DenseLayer<NextNodeCount, NodeCount> &nextLayer) noexcept {
+    for (size_t i{}; i < NodeCount; ++i) {
+      double weightedErrorSum{};
+
+      for (size_t j{}; j < NextNodeCount; ++j) {
+        weightedErrorSum += nextLayer.myError[j] * nextLayer.myWeights[j][i];
+      }
+      myError[i] = weightedErrorSum * actFuncDelta(myActFunc, myOutput[i]);
+    }
+  }
+
+  /**
+   * @brief Perform optimization with the given input.
+   *
+   * @param[in] input Input values of the last feedforward.
+   * @param[in] learningRate Learning rate to use for optimization.
+   */
+  constexpr void optimize(const double (&input)[WeightCount],
+                          const double learningRate) noexcept {
+    for (size_t i{}; i < NodeCount; ++i) {
+      myBias[i] += myError[i] * learningRate;
+
+      for (size_t j{}; j < WeightCount; ++j) {
+        myWeights[i][j] += myError[i] * learningRate * input[j];
+      }
+    }
+  }
+
+private:
+  template <size_t, size_t> friend class DenseLayer;
+
+  /** Array holding the node outputs. */
+  double myOutput[NodeCount];
+
+  /** Array holding the node errors. */
+  double myError[NodeCount];
+
+  /** Array holding the node bias values. */
+  double myBias[NodeCount];
+
+  /** Array holding the node weights, [node][weight]. */
+  double myWeights[NodeCount][WeightCount];
+
+  /** The activation function to use in this layer. */
+  ml::ActFunc myActFunc;
+};
+} // namespace ml::fixed
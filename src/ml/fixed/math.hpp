@@ -0,0 +1,109 @@
+/**
+ * @brief Math functions that can be evaluated at compile time.
+ */
+#pragma once
+
+#include <float.h>
+#include <stddef.h>
+
+namespace ml::fixed {
+/**
+ * @brief Get the absolute value.
+ *
+ * @param[in] x The input value.
+ *
+ * @return |x|.
+ */
+constexpr double abs(const double x) noexcept { return 0.0 > x ? -x : x; }
+
+/**
+ * @brief Compute the square root with Newton's method.
+ *
+ * @param[in] x The input value, must not be negative.
+ *
+ * @return The square root of x, or 0 if x isn't positive.
+ */
+constexpr double sqrt(const double x) noexcept {
+  if (!(0.0 < x)) {
+    return 0.0;
+  }
+  if (DBL_MAX < x) {
+    return x;
+  }
+  // Reduce x = m * 4^k with m in [1, 4), then sqrt(x) = sqrt(m) * 2^k. The
+  // scaling by powers of 2 is exact.
+  auto m{x};
+  auto scale{1.0};
+
+  while (4.0 <= m) {
+    m *= 0.25;
+    scale *= 2.0;
+  }
+  while (1.0 > m) {
+    m *= 4.0;
+    scale *= 0.5;
+  }
+  // Starting above the root, Newton's method decreases monotonically until
+  // it stops improving, a handful of steps within [1, 4).
+  auto root{m};
+
+  while (true) {
+    const auto next{0.5 * (root + m / root)};
+
+    if (next >= root) {
+      break;
+    }
+    root = next;
+  }
+  return root * scale;
+}
+
+/**
+ * @brief Compute the exponential function.
+ *
+ * @param[in] x The input value.
+ *
+ * @return e^x.
+ */
+constexpr double exp(const double x) noexcept {
+  // Halve the argument until the series converges quickly, then square the
+  // result back up: e^x = (e^(x / 2^k))^(2^k).
+  auto reduced{x};
+  size_t halvings{};
+
+  while ((1.0 / 16.0 < abs(reduced)) && (64U > halvings)) {
+    reduced *= 0.5;
+    ++halvings;
+  }
+
+  double sum{1.0};
+  double term{1.0};
+
+  for (size_t n{1U}; n < 12U; ++n) {
+    term *= reduced / static_cast<double>(n);
+    sum += term;
+  }
+  for (size_t i{}; i < halvings; ++i) {
+    sum *= sum;
+  }
+  return sum;
+}
+
+/**
+ * @brief Compute the hyperbolic tangent.
+ *
+ * @param[in] x The input value.
+ *
+ * @return tanh(x).
+ */
+constexpr double tanh(const double x) noexcept {
+  // Saturated in double precision beyond |x| = 20.
+  if (20.0 < x) {
+    return 1.0;
+  }
+  if (-20.0 > x) {
+    return -1.0;
+  }
+  return 1.0 - 2.0 / (exp(2.0 * x) + 1.0);
+}
+} // namespace ml::fixed
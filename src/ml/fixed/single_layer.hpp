@@ -0,0 +1,176 @@
+/**
+ * @brief Single layer neural network with compile-time dimensions.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/fixed/dense_layer.hpp"
+#include "ml/fixed/math.hpp"
+#include "ml/random/prng.hpp"
+#include "ml/types.hpp"
+
+namespace ml::fixed {
+/**
+ * @brief Single layer neural network with compile-time dimensions.
+ *
+ *        Everything, including initialization and training, can run in a
+ *        constant expression. A network trained on a constant dataset in a
+ *        constexpr variable ends up in read-only data with its final weights,
+ *        and a static_assert on isPredictDone() turns a model that doesn't
+ *        converge into a compile error:
+ *
+ *        constexpr auto model{trainModel()};
+ *        static_assert(model.isPredictDone(inputs, outputs));
+ *
+ *        Evaluation cost is bounded by the compiler's constexpr limits (GCC:
+ *        -fconstexpr-ops-limit), so this suits small networks and datasets.
+ *
+ * @tparam InputCount The number of inputs.
+ * @tparam HiddenCount The number of nodes in the hidden layer.
+ * @tparam OutputCount The number of outputs.
+ */
+template <size_t InputCount, size_t HiddenCount, size_t OutputCount>
+class SingleLayer final {
+public:
+  /**
+   * @brief Create a new network.
+   *
+   * @param[in, out] prng The generator to draw the initial weights from.
+   * @param[in] hiddenActFunc The activation of the hidden layer
+   *                          (default = ReLU).
+   * @param[in] outputActFunc The activation of the output layer
+   *                          (default = ReLU).
+   */
+  explicit constexpr SingleLayer(
+      ml::random::Prng &prng,
+      const ml::ActFunc hiddenActFunc = ml::ActFunc::Relu,
+      const ml::ActFunc outputActFunc = ml::ActFunc::Relu) noexcept
+      : myHiddenLayer{prng, hiddenActFunc}, myOutputLayer{prng, outputActFunc},
+        myEpochsUsed{} {}
+
+  /**
+   * @brief Predict the output for the given input.
+   *
+   *        Only reads the parameters, so it can run on a network in
+   *        read-only data.
+   *
+   * @param[in] input Input values.
+   * @param[out] output Output values.
+   */
+  constexpr void predict(const double (&input)[InputCount],
+                         double (&output)[OutputCount]) const noexcept {
+    double hidden[HiddenCount]{};
+    myHiddenLayer.compute(input, hidden);
+    myOutputLayer.compute(hidden, output);
+  }
+
+  /**
+   * @brief Train the network until the predictions are within tolerance.
+   *
+   * @tparam SampleCount The number of training samples.
+   *
+   * @param[in] inputs Training inputs, [sample][input].
+   * @param[in] outputs Training outputs, [sample][output].
+   * @param[in] learningRate The learning rate to use.
+   * @param[in] maxEpochs The maximum number of epochs to run.
+   * @param[in] tolerance The largest accepted prediction error
+   *                      (default = 0.1).
+   *
+   * @return True if the tolerance was reached, or false if not.
+   */
+  template <size_t SampleCount>
+  constexpr bool train(const double (&inputs)[SampleCount][InputCount],
+                       const double (&outputs)[SampleCount][OutputCount],
+                       const double learningRate, const size_t maxEpochs,
+                       const double tolerance = 0.1) noexcept {
+    while (!isPredictDone(inputs, outputs, tolerance)) {
+      if (maxEpochs <= myEpochsUsed) {
+        return false;
+      }
+      for (size_t k{}; k < SampleCount; ++k) {
+        // (a) forward: hidden then output
+        myHiddenLayer.feedforward(inputs[k]);
+        myOutputLayer.feedforward(myHiddenLayer.output());
+
+        // (b) backprop: output with target, then hidden with next layer
+        myOutputLayer.backpropagate(outputs[k]);
+        myHiddenLayer.backpropagate(myOutputLayer);
+
+        // (c) optimize: each layer with its own input source
+        myHiddenLayer.optimize(inputs[k], learningRate);
+        myOutputLayer.optimize(myHiddenLayer.output(), learningRate);
+      }
+      ++myEpochsUsed;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Check if the prediction is within tolerance for a dataset.
+   *
+   * @tparam SampleCount The number of samples.
+   *
+   * @param[in] inputs Inputs, [sample][input].
+   * @param[in] outputs Expected outputs, [sample][output].
+   * @param[in] tolerance The largest accepted prediction error
+   *                      (default = 0.1).
+   *
+   * @return True if every prediction is within tolerance, or false if not.
+   */
+  template <size_t SampleCount>
+  constexpr bool
+  isPredictDone(const double (&inputs)[SampleCount][InputCount],
+                const double (&outputs)[SampleCount][OutputCount],
+                const double tolerance = 0.1) const noexcept {
+    for (size_t k{}; k < SampleCount; ++k) {
+      double prediction[OutputCount]{};
+      predict(inputs[k], prediction);
+
+      for (size_t i{}; i < OutputCount; ++i) {
+        if (abs(prediction[i] - outputs[k][i]) > tolerance) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Get the amount of epochs used during training.
+   *
+   * @return The number of epochs used.
+   */
+  constexpr size_t getEpochsUsed() const noexcept { return myEpochsUsed; }
+
+  /**
+   * @brief Get the hidden layer.
+   *
+   * @return The hidden layer.
+   */
+  constexpr const DenseLayer<HiddenCount, InputCount> &
+  hiddenLayer() const noexcept {
+    return myHiddenLayer;
+  }
+
+  /**
+   * @brief Get the output layer.
+   *
+   * @return The output layer.
+   */
+  constexpr const DenseLayer<OutputCount, HiddenCount> &
+  outputLayer() const noexcept {
+    return myOutputLayer;
+  }
+
+private:
+  /** The hidden layer. */
+  DenseLayer<HiddenCount, InputCount> myHiddenLayer;
+
+  /** The output layer. */
+  DenseLayer<OutputCount, HiddenCount> myOutputLayer;
+
+  /** The amount of epochs used. */
+  size_t myEpochsUsed;
+};
+} // namespace ml::fixed
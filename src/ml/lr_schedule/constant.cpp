@@ -0,0 +1,18 @@
+/**
+ * @brief Constant learning rate schedule implementation details.
+ */
+#include "ml/lr_schedule/constant.hpp"
+
+namespace ml::lr_schedule {
+// -----------------------------------------------------------------------------
+Constant::Constant(const double rate) noexcept : myRate{rate} {}
+
+// -----------------------------------------------------------------------------
+double Constant::rate() const noexcept { return myRate; }
+
+// -----------------------------------------------------------------------------
+void Constant::step(const double) noexcept {}
+
+// -----------------------------------------------------------------------------
+void Constant::reset() noexcept {}
+} // namespace ml::lr_schedule
@@ -0,0 +1,51 @@
+/**
+ * @brief Constant learning rate schedule.
+ */
+#pragma once
+
+#include "ml/lr_schedule/interface.hpp"
+
+namespace ml::lr_schedule {
+/**
+ * @brief Constant learning rate schedule.
+ */
+class Constant final : public Interface {
+public:
+  /**
+   * @brief Create a new constant schedule.
+   *
+   * @param[in] rate The learning rate to use for every epoch.
+   */
+  explicit Constant(const double rate) noexcept;
+
+  /**
+   * @brief Delete the schedule.
+   */
+  ~Constant() noexcept override = default;
+
+  /**
+   * @brief Get the learning rate of the current epoch.
+   *
+   * @return The learning rate to use.
+   */
+  double rate() const noexcept override;
+
+  /**
+   * @brief Advance the schedule to the next epoch.
+   *
+   * @param[in] loss The training loss of the finished epoch (unused).
+   */
+  void step(const double loss) noexcept override;
+
+  /**
+   * @brief Restart the schedule from the first epoch.
+   */
+  void reset() noexcept override;
+
+  Constant() = delete; // No default constructor.
+
+private:
+  /** The learning rate. */
+  const double myRate;
+};
+} // namespace ml::lr_schedule
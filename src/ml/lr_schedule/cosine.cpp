@@ -0,0 +1,38 @@
+/**
+ * @brief Cosine annealing learning rate schedule implementation details.
+ */
+#include <math.h>
+
+#include "ml/lr_schedule/cosine.hpp"
+
+namespace ml::lr_schedule {
+namespace {
+/** M_PI is a POSIX extension, not part of standard C++. */
+constexpr double Pi{3.14159265358979323846};
+} // namespace
+
+// -----------------------------------------------------------------------------
+Cosine::Cosine(const double initialRate, const double minRate,
+               const size_t period) noexcept
+    : myInitialRate{initialRate}, myMinRate{minRate},
+      myPeriod{0U < period ? period : 1U}, myEpoch{} {}
+
+// -----------------------------------------------------------------------------
+double Cosine::rate() const noexcept {
+  const auto progress{static_cast<double>(myEpoch) /
+                      static_cast<double>(myPeriod)};
+  return myMinRate +
+         0.5 * (myInitialRate - myMinRate) * (1.0 + cos(Pi * progress));
+}
+
+// -----------------------------------------------------------------------------
+void Cosine::step(const double) noexcept {
+  // Hold the minimum rate once the period has passed.
+  if (myEpoch < myPeriod) {
+    ++myEpoch;
+  }
+}
+
+// -----------------------------------------------------------------------------
+void Cosine::reset() noexcept { myEpoch = 0U; }
+} // namespace ml::lr_schedule
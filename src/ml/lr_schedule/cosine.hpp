@@ -0,0 +1,70 @@
+/**
+ * @brief Cosine annealing learning rate schedule.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/lr_schedule/interface.hpp"
+
+namespace ml::lr_schedule {
+/**
+ * @brief Cosine annealing learning rate schedule.
+ *
+ *        rate = min_rate + (initial_rate - min_rate) *
+ *               (1 + cos(pi * epoch / period)) / 2
+ *
+ *        The rate stays at the minimum once the period has passed.
+ */
+class Cosine final : public Interface {
+public:
+  /**
+   * @brief Create a new cosine schedule.
+   *
+   * @param[in] initialRate The learning rate of the first epoch.
+   * @param[in] minRate The learning rate at the end of the period.
+   * @param[in] period The number of epochs to anneal over. Must exceed 0.
+   */
+  explicit Cosine(const double initialRate, const double minRate,
+                  const size_t period) noexcept;
+
+  /**
+   * @brief Delete the schedule.
+   */
+  ~Cosine() noexcept override = default;
+
+  /**
+   * @brief Get the learning rate of the current epoch.
+   *
+   * @return The learning rate to use.
+   */
+  double rate() const noexcept override;
+
+  /**
+   * @brief Advance the schedule to the next epoch.
+   *
+   * @param[in] loss The training loss of the finished epoch (unused).
+   */
+  void step(const double loss) noexcept override;
+
+  /**
+   * @brief Restart the schedule from the first epoch.
+   */
+  void reset() noexcept override;
+
+  Cosine() = delete; // No default constructor.
+
+private:
+  /** The learning rate of the first epoch. */
+  const double myInitialRate;
+
+  /** The learning rate at the end of the period. */
+  const double myMinRate;
+
+  /** The number of epochs to anneal over. */
+  const size_t myPeriod;
+
+  /** The current epoch. */
+  size_t myEpoch;
+};
+} // namespace ml::lr_schedule
@@ -0,0 +1,39 @@
+/**
+ * @brief Learning rate schedule interface.
+ */
+#pragma once
+
+namespace ml::lr_schedule {
+/**
+ * @brief Learning rate schedule interface.
+ *
+ *        A schedule provides the learning rate of the current epoch and is
+ *        advanced once per epoch with the training loss of that epoch.
+ */
+class Interface {
+public:
+  /**
+   * @brief Delete the schedule.
+   */
+  virtual ~Interface() noexcept = default;
+
+  /**
+   * @brief Get the learning rate of the current epoch.
+   *
+   * @return The learning rate to use.
+   */
+  virtual double rate() const = 0;
+
+  /**
+   * @brief Advance the schedule to the next epoch.
+   *
+   * @param[in] loss The training loss of the finished epoch.
+   */
+  virtual void step(const double loss) = 0;
+
+  /**
+   * @brief Restart the schedule from the first epoch.
+   */
+  virtual void reset() = 0;
+};
+} // namespace ml::lr_schedule
@@ -0,0 +1,39 @@
+/**
+ * @brief Reduce-on-plateau learning rate schedule implementation details.
+ */
+#include "ml/lr_schedule/reduce_on_plateau.hpp"
+
+namespace ml::lr_schedule {
+// -----------------------------------------------------------------------------
+ReduceOnPlateau::ReduceOnPlateau(const double initialRate, const double factor,
+                                 const size_t patience, const double minRate,
+                                 const double threshold) noexcept
+    : myInitialRate{initialRate}, myFactor{factor}, myPatience{patience},
+      myMinRate{minRate}, myThreshold{threshold}, myRate{initialRate},
+      myBestLoss{-1.0}, myBadEpochs{} {}
+
+// -----------------------------------------------------------------------------
+double ReduceOnPlateau::rate() const noexcept { return myRate; }
+
+// -----------------------------------------------------------------------------
+void ReduceOnPlateau::step(const double loss) noexcept {
+  // Any loss clearly below the best one so far counts as progress.
+  if ((0.0 > myBestLoss) || (loss < myBestLoss * (1.0 - myThreshold))) {
+    myBestLoss = loss;
+    myBadEpochs = 0U;
+    return;
+  }
+  if (++myBadEpochs > myPatience) {
+    const auto reduced{myRate * myFactor};
+    myRate = reduced > myMinRate ? reduced : myMinRate;
+    myBadEpochs = 0U;
+  }
+}
+
+// -----------------------------------------------------------------------------
+void ReduceOnPlateau::reset() noexcept {
+  myRate = myInitialRate;
+  myBestLoss = -1.0;
+  myBadEpochs = 0U;
+}
+} // namespace ml::lr_schedule
@@ -0,0 +1,86 @@
+/**
+ * @brief Reduce-on-plateau learning rate schedule.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/lr_schedule/interface.hpp"
+
+namespace ml::lr_schedule {
+/**
+ * @brief Reduce-on-plateau learning rate schedule.
+ *
+ *        The rate is multiplied by the factor whenever the loss hasn't
+ *        improved by the relative threshold for more than patience epochs.
+ */
+class ReduceOnPlateau final : public Interface {
+public:
+  /**
+   * @brief Create a new reduce-on-plateau schedule.
+   *
+   * @param[in] initialRate The learning rate of the first epoch.
+   * @param[in] factor The factor to reduce the rate with (default = 0.5).
+   * @param[in] patience The number of epochs without improvement to accept
+   *                     (default = 10).
+   * @param[in] minRate The lowest rate to reduce to (default = 1e-6).
+   * @param[in] threshold The relative loss decrease that counts as an
+   *                      improvement (default = 1e-3).
+   */
+  explicit ReduceOnPlateau(const double initialRate, const double factor = 0.5,
+                           const size_t patience = 10U,
+                           const double minRate = 1e-6,
+                           const double threshold = 1e-3) noexcept;
+
+  /**
+   * @brief Delete the schedule.
+   */
+  ~ReduceOnPlateau() noexcept override = default;
+
+  /**
+   * @brief Get the learning rate of the current epoch.
+   *
+   * @return The learning rate to use.
+   */
+  double rate() const noexcept override;
+
+  /**
+   * @brief Advance the schedule to the next epoch.
+   *
+   * @param[in] loss The training loss of the finished epoch.
+   */
+  void step(const double loss) noexcept override;
+
+  /**
+   * @brief Restart the schedule from the first epoch.
+   */
+  void reset() noexcept override;
+
+  ReduceOnPlateau() = delete; // No default constructor.
+
+private:
+  /** The learning rate of the first epoch. */
+  const double myInitialRate;
+
+  /** The factor to reduce the rate with. */
+  const double myFactor;
+
+  /** The number of epochs without improvement to accept. */
+  const size_t myPatience;
+
+  /** The lowest rate to reduce to. */
+  const double myMinRate;
+
+  /** The relative loss decrease that counts as an improvement. */
+  const double myThreshold;
+
+  /** The learning rate of the current epoch. */
+  double myRate;
+
+  /** The lowest loss seen so far, negative before the first epoch. */
+  double myBestLoss;
+
+  /** The number of epochs since the last improvement. */
+  size_t myBadEpochs;
+};
+} // namespace ml::lr_schedule
@@ -0,0 +1,31 @@
+/**
+ * @brief Step decay learning rate schedule implementation details.
+ */
+#include "ml/lr_schedule/step_decay.hpp"
+
+namespace ml::lr_schedule {
+// -----------------------------------------------------------------------------
+StepDecay::StepDecay(const double initialRate, const double factor,
+                     const size_t stepSize) noexcept
+    : myInitialRate{initialRate}, myFactor{factor},
+      myStepSize{0U < stepSize ? stepSize : 1U}, myRate{initialRate},
+      myEpoch{} {}
+
+// -----------------------------------------------------------------------------
+double StepDecay::rate() const noexcept { return myRate; }
+
+// -----------------------------------------------------------------------------
+void StepDecay::step(const double) noexcept {
+  // Decay the rate once every step size epochs.
+  if (++myEpoch >= myStepSize) {
+    myEpoch = 0U;
+    myRate *= myFactor;
+  }
+}
+
+// -----------------------------------------------------------------------------
+void StepDecay::reset() noexcept {
+  myRate = myInitialRate;
+  myEpoch = 0U;
+}
+} // namespace ml::lr_schedule
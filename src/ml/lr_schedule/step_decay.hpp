@@ -0,0 +1,72 @@
+/**
+ * @brief Step decay learning rate schedule.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/lr_schedule/interface.hpp"
+
+namespace ml::lr_schedule {
+/**
+ * @brief Step decay learning rate schedule.
+ *
+ *        rate = initial_rate * factor ^ floor(epoch / step_size)
+ */
+class StepDecay final : public Interface {
+public:
+  /**
+   * @brief Create a new step decay schedule.
+   *
+   * @param[in] initialRate The learning rate of the first epoch.
+   * @param[in] factor The factor to multiply the rate with every step,
+   *                   0 < factor <= 1 (default = 0.5).
+   * @param[in] stepSize The number of epochs per step. Must exceed 0
+   *                     (default = 100).
+   */
+  explicit StepDecay(const double initialRate, const double factor = 0.5,
+                     const size_t stepSize = 100U) noexcept;
+
+  /**
+   * @brief Delete the schedule.
+   */
+  ~StepDecay() noexcept override = default;
+
+  /**
+   * @brief Get the learning rate of the current epoch.
+   *
+   * @return The learning rate to use.
+   */
+  double rate() const noexcept override;
+
+  /**
+   * @brief Advance the schedule to the next epoch.
+   *
+   * @param[in] loss The training loss of the finished epoch (unused).
+   */
+  void step(const double loss) noexcept override;
+
+  /**
+   * @brief Restart the schedule from the first epoch.
+   */
+  void reset() noexcept override;
+
+  StepDecay() = delete; // No default constructor.
+
+private:
+  /** The learning rate of the first epoch. */
+  const double myInitialRate;
+
+  /** The factor to multiply the rate with every step. */
+  const double myFactor;
+
+  /** The number of epochs per step. */
+  const size_t myStepSize;
+
+  /** The learning rate of the current epoch. */
+  double myRate;
+
+  /** The number of epochs since the last step. */
+  size_t myEpoch;
+};
+} // namespace ml::lr_schedule
@@ -0,0 +1,35 @@
+/**
+ * @brief Linear warmup learning rate schedule implementation details.
+ */
+#include "ml/lr_schedule/warmup.hpp"
+
+namespace ml::lr_schedule {
+// -----------------------------------------------------------------------------
+Warmup::Warmup(Interface &schedule, const size_t warmupEpochs) noexcept
+    : mySchedule{schedule}, myWarmupEpochs{warmupEpochs}, myEpoch{} {}
+
+// -----------------------------------------------------------------------------
+double Warmup::rate() const noexcept {
+  // Ramp up from 1 / (warmup + 1) of the target rate.
+  if (myEpoch < myWarmupEpochs) {
+    return mySchedule.rate() * static_cast<double>(myEpoch + 1U) /
+           static_cast<double>(myWarmupEpochs + 1U);
+  }
+  return mySchedule.rate();
+}
+
+// -----------------------------------------------------------------------------
+void Warmup::step(const double loss) noexcept {
+  if (myEpoch < myWarmupEpochs) {
+    ++myEpoch;
+  } else {
+    mySchedule.step(loss);
+  }
+}
+
+// -----------------------------------------------------------------------------
+void Warmup::reset() noexcept {
+  myEpoch = 0U;
+  mySchedule.reset();
+}
+} // namespace ml::lr_schedule
@@ -0,0 +1,65 @@
+/**
+ * @brief Linear warmup learning rate schedule.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/lr_schedule/interface.hpp"
+
+namespace ml::lr_schedule {
+/**
+ * @brief Linear warmup in front of another schedule.
+ *
+ *        During the first warmup epochs the rate ramps linearly up to the
+ *        rate of the wrapped schedule, which is only advanced afterwards.
+ */
+class Warmup final : public Interface {
+public:
+  /**
+   * @brief Create a new warmup schedule.
+   *
+   * @param[in] schedule The schedule to use after the warmup.
+   * @param[in] warmupEpochs The number of epochs to ramp up over.
+   */
+  explicit Warmup(Interface &schedule, const size_t warmupEpochs) noexcept;
+
+  /**
+   * @brief Delete the schedule.
+   */
+  ~Warmup() noexcept override = default;
+
+  /**
+   * @brief Get the learning rate of the current epoch.
+   *
+   * @return The learning rate to use.
+   */
+  double rate() const noexcept override;
+
+  /**
+   * @brief Advance the schedule to the next epoch.
+   *
+   * @param[in] loss The training loss of the finished epoch.
+   */
+  void step(const double loss) noexcept override;
+
+  /**
+   * @brief Restart the schedule, including the wrapped one.
+   */
+  void reset() noexcept override;
+
+  Warmup() = delete;                          // No default constructor.
+  Warmup(const Warmup &) = delete;            // No copy constructor.
+  Warmup &operator=(const Warmup &) = delete; // No copy assignment.
+
+private:
+  /** The schedule to use after the warmup. */
+  Interface &mySchedule;
+
+  /** The number of epochs to ramp up over. */
+  const size_t myWarmupEpochs;
+
+  /** The current epoch, counted up to the end of the warmup. */
+  size_t myEpoch;
+};
+} // namespace ml::lr_schedule
@@ -0,0 +1,27 @@
+/**
+ * @brief Activation memory shared by the layers of one or more models
+ *        implementation details.
+ */
+#include "ml/model/activation_arena.hpp"
+
+namespace ml::model {
+// -----------------------------------------------------------------------------
+ActivationArena::ActivationArena() noexcept : myValues{} {}
+
+// -----------------------------------------------------------------------------
+bool ActivationArena::reserve(const size_t size) noexcept {
+  // Grow only, a smaller model shares the arena of a larger one.
+  return (myValues.size() >= size) || myValues.resize(size);
+}
+
+// -----------------------------------------------------------------------------
+size_t ActivationArena::size() const noexcept { return myValues.size(); }
+
+// -----------------------------------------------------------------------------
+double *ActivationArena::data() noexcept {
+  return myValues.empty() ? nullptr : &myValues[0U];
+}
+
+// -----------------------------------------------------------------------------
+ml::Matrix1d &ActivationArena::values() noexcept { return myValues; }
+} // namespace ml::model
@@ -0,0 +1,124 @@
+/**
+ * @brief Activation memory shared by the layers of one or more models.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/types.hpp"
+
+namespace ml::model {
+/**
+ * @brief Get the number of values needed for the activations of a layer
+ *        stack.
+ *
+ *        The output of layer i is produced by layer i and last read by
+ *        layer i + 1, so only two activations are live at any time. Placing
+ *        them alternately at the front and the back of the arena (see
+ *        activationOffset()) lets them share it without overlapping, as long
+ *        as it holds the widest pair of adjacent layers.
+ *
+ * @param[in] widths The output width of every layer, input layer first.
+ * @param[in] layerCount The number of layers.
+ *
+ * @return The number of values, max(widths[i - 1] + widths[i]).
+ */
+constexpr size_t activationSize(const size_t widths[],
+                                const size_t layerCount) noexcept {
+  size_t size{0U < layerCount ? widths[0U] : 0U};
+
+  for (size_t i{1U}; i < layerCount; ++i) {
+    const auto pairSize{widths[i - 1U] + widths[i]};
+    size = size < pairSize ? pairSize : size;
+  }
+  return size;
+}
+
+/**
+ * @brief Get the position of a layer's output within the arena.
+ *
+ *        Even layers write at the front, odd layers at the back, so every
+ *        layer reads its input from one end and writes to the other.
+ *
+ * @param[in] widths The output width of every layer, input layer first.
+ * @param[in] layer The index of the layer.
+ * @param[in] arenaSize The number of values in the arena, at least
+ *                      activationSize().
+ *
+ * @return The index of the first output value of the layer.
+ */
+constexpr size_t activationOffset(const size_t widths[], const size_t layer,
+                                  const size_t arenaSize) noexcept {
+  return 0U == layer % 2U ? 0U : arenaSize - widths[layer];
+}
+
+/**
+ * @brief Activation memory shared by the layers of one or more models.
+ *
+ *        One block of values replaces an output buffer per layer, so the
+ *        activation RAM is bounded by the widest pair of adjacent layers
+ *        instead of the sum of all layers. Models running one after another
+ *        can share an arena, it is sized for the largest of them. Models
+ *        sharing an arena must not predict concurrently.
+ *
+ *        Reentrant predictions only read the model and write into the
+ *        caller's arena, so any number of threads can predict with one model
+ *        at the same time, each with its own arena, as long as the model
+ *        isn't trained or reloaded meanwhile.
+ */
+class ActivationArena final {
+public:
+  /**
+   * @brief Create a new empty arena.
+   */
+  ActivationArena() noexcept;
+
+  /**
+   * @brief Delete the arena.
+   */
+  ~ActivationArena() noexcept = default;
+
+  /**
+   * @brief Make sure the arena holds at least the given number of values.
+   *
+   *        The arena only grows, which moves the values. Fetch data() again
+   *        after reserving.
+   *
+   * @param[in] size The number of values needed, see activationSize().
+   *
+   * @return True if the arena holds the values, or false on allocation
+   *         failure.
+   */
+  bool reserve(const size_t size) noexcept;
+
+  /**
+   * @brief Get the number of values in the arena.
+   *
+   * @return The number of values.
+   */
+  size_t size() const noexcept;
+
+  /**
+   * @brief Get the values of the arena.
+   *
+   * @return Pointer to size() values, nullptr if the arena is empty.
+   */
+  double *data() noexcept;
+
+  /**
+   * @brief Get the values of the arena, for the kernels that take a vector.
+   *
+   * @return Reference to the size() values.
+   */
+  ml::Matrix1d &values() noexcept;
+
+  ActivationArena(const ActivationArena &) = delete;            // No copy.
+  ActivationArena(ActivationArena &&) = delete;                 // No move.
+  ActivationArena &operator=(const ActivationArena &) = delete; // No copy.
+  ActivationArena &operator=(ActivationArena &&) = delete;      // No move.
+
+private:
+  /** The values of the arena. */
+  ml::Matrix1d myValues;
+};
+} // namespace ml::model
@@ -0,0 +1,166 @@
+/**
+ * @brief Model storage in a flash partition implementation details.
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#include "ml/model/flash_partition.hpp"
+#include "ml/model/format.hpp"
+
+#ifdef CONFIG_FLASH_MAP
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+
+#if FIXED_PARTITION_EXISTS(model_partition)
+#define ML_MODEL_PARTITION model_partition
+#elif FIXED_PARTITION_EXISTS(storage_partition)
+#define ML_MODEL_PARTITION storage_partition
+#endif
+#endif
+
+// Espressif SoCs only map the application image, data partitions are mapped
+// through the flash MMU when opened.
+#ifdef CONFIG_SOC_FAMILY_ESPRESSIF_ESP32
+#if __has_include(<spi_flash_mmap.h>)
+#include <spi_flash_mmap.h>
+#else
+#include <esp_spi_flash.h>
+#endif
+#define ML_MODEL_PARTITION_MMU
+#elif defined(CONFIG_XIP)
+#define ML_MODEL_PARTITION_MAPPED
+#endif
+
+namespace ml::model {
+// -----------------------------------------------------------------------------
+FlashPartition::FlashPartition() noexcept
+    : myData{nullptr}, mySize{}, myCopy{nullptr}, myMapHandle{} {}
+
+// -----------------------------------------------------------------------------
+FlashPartition::~FlashPartition() noexcept { close(); }
+
+// -----------------------------------------------------------------------------
+bool FlashPartition::open() noexcept {
+#ifdef ML_MODEL_PARTITION
+  close();
+
+  const size_t size{FIXED_PARTITION_SIZE(ML_MODEL_PARTITION)};
+
+#ifdef ML_MODEL_PARTITION_MAPPED
+  // Flash is memory-mapped, use the partition in place.
+  myData = reinterpret_cast<const void *>(
+      CONFIG_FLASH_BASE_ADDRESS + FIXED_PARTITION_OFFSET(ML_MODEL_PARTITION));
+  mySize = size;
+  return true;
+#else
+  const flash_area *area{nullptr};
+
+  if (0 != flash_area_open(FIXED_PARTITION_ID(ML_MODEL_PARTITION), &area)) {
+    printk("failed to open model partition\n");
+    return false;
+  }
+  // Read only the model header first, so a small model doesn't cost a copy
+  // or mapping of the whole partition.
+  Header header{};
+  auto readSize{sizeof(header)};
+
+  if ((0 == flash_area_read(area, 0, &header, sizeof(header))) &&
+      (Magic == header.magic) && (header.size <= size) &&
+      (sizeof(header) < header.size)) {
+    readSize = header.size;
+  }
+#ifdef ML_MODEL_PARTITION_MMU
+  // The MMU maps whole pages, map from the page the partition starts in.
+  const auto offset{static_cast<size_t>(area->fa_off)};
+  const auto pageOffset{offset % SPI_FLASH_MMU_PAGE_SIZE};
+  const void *page{nullptr};
+  spi_flash_mmap_handle_t handle{};
+  flash_area_close(area);
+
+  if (ESP_OK != spi_flash_mmap(offset - pageOffset, pageOffset + readSize,
+                               SPI_FLASH_MMAP_DATA, &page, &handle)) {
+    printk("failed to map model partition\n");
+    return false;
+  }
+  myMapHandle = handle;
+  myData = static_cast<const uint8_t *>(page) + pageOffset;
+#else
+  myCopy = new uint8_t[readSize];
+
+  if ((nullptr == myCopy) ||
+      (0 != flash_area_read(area, 0, myCopy, readSize))) {
+    flash_area_close(area);
+    close();
+    printk("failed to read model partition\n");
+    return false;
+  }
+  flash_area_close(area);
+  myData = myCopy;
+#endif
+  mySize = readSize;
+  return true;
+#endif
+#else
+  printk("no model partition available\n");
+  return false;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+const void *FlashPartition::data() const noexcept { return myData; }
+
+// -----------------------------------------------------------------------------
+size_t FlashPartition::size() const noexcept { return mySize; }
+
+// -----------------------------------------------------------------------------
+bool FlashPartition::store(const void *data, const size_t size) noexcept {
+#ifdef ML_MODEL_PARTITION
+  close();
+
+  const flash_area *area{nullptr};
+
+  if (0 != flash_area_open(FIXED_PARTITION_ID(ML_MODEL_PARTITION), &area)) {
+    printk("failed to open model partition\n");
+    return false;
+  }
+  // Erase only the sectors the model covers, erasing is slow and the rest of
+  // the partition may hold other data.
+  flash_pages_info sector{};
+  size_t eraseSize{};
+
+  if ((0 == flash_get_page_info_by_offs(flash_area_get_device(area),
+                                        area->fa_off, &sector)) &&
+      (0U < sector.size)) {
+    eraseSize = (size + sector.size - 1U) / sector.size * sector.size;
+  }
+  const auto result{(0U < eraseSize) && (eraseSize <= area->fa_size) &&
+                    (0 == flash_area_erase(area, 0, eraseSize)) &&
+                    (0 == flash_area_write(area, 0, data, size))};
+  flash_area_close(area);
+
+  if (!result) {
+    printk("failed to write model partition\n");
+  }
+  return result;
+#else
+  (void)data;
+  (void)size;
+  printk("no model partition available\n");
+  return false;
+#endif
+}
+
+// -----------------------------------------------------------------------------
+void FlashPartition::close() noexcept {
+#ifdef ML_MODEL_PARTITION_MMU
+  if (nullptr != myData) {
+    spi_flash_munmap(static_cast<spi_flash_mmap_handle_t>(myMapHandle));
+  }
+  myMapHandle = 0U;
+#endif
+  delete[] myCopy;
+  myCopy = nullptr;
+  myData = nullptr;
+  mySize = 0U;
+}
+} // namespace ml::model
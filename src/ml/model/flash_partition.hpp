@@ -0,0 +1,90 @@
+/**
+ * @brief Model storage in a flash partition.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace ml::model {
+/**
+ * @brief Model storage in a flash partition.
+ *
+ *        Uses the fixed partition labeled model_partition, or
+ *        storage_partition if the devicetree has none. On targets where flash
+ *        is memory-mapped the partition is read in place. Espressif SoCs map
+ *        the model through the flash MMU when opened, other targets read it
+ *        into RAM once.
+ *
+ *        Requires CONFIG_FLASH_MAP, without it every call fails.
+ */
+class FlashPartition final {
+public:
+  /**
+   * @brief Create a new partition handle.
+   */
+  FlashPartition() noexcept;
+
+  /**
+   * @brief Delete the partition handle.
+   */
+  ~FlashPartition() noexcept;
+
+  /**
+   * @brief Open the partition and make its content readable.
+   *
+   * @return True if the partition was opened, or false on error.
+   */
+  bool open() noexcept;
+
+  /**
+   * @brief Get the partition content.
+   *
+   * @return The partition bytes, or nullptr if not opened.
+   */
+  const void *data() const noexcept;
+
+  /**
+   * @brief Get the size of the partition.
+   *
+   * @return The size in bytes, or 0 if not opened.
+   */
+  size_t size() const noexcept;
+
+  /**
+   * @brief Write the given bytes to the start of the partition.
+   *
+   *        Only the sectors the bytes cover are erased, which requires
+   *        CONFIG_FLASH_PAGE_LAYOUT.
+   *
+   *        The partition is closed afterwards and has to be opened again to
+   *        read the new content.
+   *
+   * @param[in] data The bytes to write.
+   * @param[in] size The number of bytes to write, a multiple of 8.
+   *
+   * @return True if the bytes were written, or false on error.
+   */
+  bool store(const void *data, const size_t size) noexcept;
+
+  FlashPartition(const FlashPartition &) = delete; // No copy constructor.
+  FlashPartition(FlashPartition &&) = delete;      // No move constructor.
+  FlashPartition &operator=(const FlashPartition &) = delete; // No copy.
+  FlashPartition &operator=(FlashPartition &&) = delete;      // No move.
+
+private:
+  void close() noexcept;
+
+  /** The partition bytes, nullptr if not opened. */
+  const void *myData;
+
+  /** The size of the partition in bytes. */
+  size_t mySize;
+
+  /** RAM copy of the partition where flash isn't memory-mapped. */
+  uint8_t *myCopy;
+
+  /** Handle of the flash MMU mapping on Espressif SoCs. */
+  uint32_t myMapHandle;
+};
+} // namespace ml::model
@@ -0,0 +1,120 @@
+/**
+ * @brief Binary model format.
+ *
+ *        A model file holds a header followed by one block per layer:
+ *
+ *        Header     magic, version, scalar type, layer count, total size and
+ *                   CRC-32 of everything after the header (16 bytes).
+ *        Layer      node count, weight count and activation function
+ *                   (8 bytes), followed by the bias values [node] and the
+ *                   weights [node][weight] in the scalar type, padded to a
+ *                   multiple of 8 bytes.
+ *
+ *        All values are stored little-endian, the native byte order of both
+ *        the device and the host. Since every block starts on an 8-byte
+ *        boundary, a model stored at an 8-byte aligned address can be read in
+ *        place without copying the weights.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ml/types.hpp"
+
+namespace ml::model {
+/** Identifies a model file, "MLNN" in memory. */
+constexpr uint32_t Magic{0x4E4E4C4DU};
+
+/** The current format version. */
+constexpr uint16_t Version{1U};
+
+/** The maximum number of layers in a model. */
+constexpr size_t MaxLayerCount{8U};
+
+/** The alignment of every block in a model. */
+constexpr size_t Alignment{8U};
+
+/**
+ * @brief Enumeration of scalar types the parameters can be stored as.
+ */
+enum class ScalarType : uint8_t {
+  Float64, ///< IEEE 754 double precision.
+  Float32, ///< IEEE 754 single precision, half the size.
+};
+
+/**
+ * @brief Model header.
+ */
+struct Header {
+  uint32_t magic;     ///< Always Magic.
+  uint16_t version;   ///< Format version of the model.
+  uint8_t scalarType; ///< ScalarType of the parameters.
+  uint8_t layerCount; ///< The number of layer blocks that follow.
+  uint32_t size;      ///< Total size of the model in bytes.
+  uint32_t crc;       ///< CRC-32 (IEEE) of the bytes after the header.
+};
+
+/**
+ * @brief Layer block header.
+ */
+struct LayerHeader {
+  uint16_t nodeCount;   ///< The number of nodes in the layer.
+  uint16_t weightCount; ///< The number of weights per node in the layer.
+  uint8_t actFunc;      ///< ActFunc of the layer.
+  uint8_t reserved[3U]; ///< Always zero.
+};
+
+static_assert(16U == sizeof(Header), "unexpected model header padding");
+static_assert(8U == sizeof(LayerHeader), "unexpected layer header padding");
+
+/**
+ * @brief Round a size up to the block alignment.
+ *
+ * @param[in] size The size to round up.
+ *
+ * @return The aligned size.
+ */
+constexpr size_t align(const size_t size) noexcept {
+  return (size + Alignment - 1U) & ~(Alignment - 1U);
+}
+
+/**
+ * @brief Get the size of a scalar type.
+ *
+ * @param[in] scalarType The scalar type.
+ *
+ * @return The size of one value in bytes.
+ */
+constexpr size_t scalarSize(const ScalarType scalarType) noexcept {
+  return ScalarType::Float32 == scalarType ? sizeof(float) : sizeof(double);
+}
+
+/**
+ * @brief Get the size of a layer block.
+ *
+ * @param[in] nodeCount The number of nodes in the layer.
+ * @param[in] weightCount The number of weights per node in the layer.
+ * @param[in] scalarType The scalar type of the parameters.
+ *
+ * @return The size of the block in bytes, including its header.
+ */
+constexpr size_t layerBytes(const size_t nodeCount, const size_t weightCount,
+                            const ScalarType scalarType) noexcept {
+  return sizeof(LayerHeader) +
+         align(nodeCount * (weightCount + 1U) * scalarSize(scalarType));
+}
+
+/**
+ * @brief Check whether a stored activation function is known.
+ *
+ * @param[in] actFunc The stored activation function.
+ *
+ * @return True if the activation function is known, or false if not.
+ */
+constexpr bool isValidActFunc(const uint8_t actFunc) noexcept {
+  return (static_cast<uint8_t>(ml::ActFunc::Relu) == actFunc) ||
+         (static_cast<uint8_t>(ml::ActFunc::Tanh) == actFunc) ||
+         (static_cast<uint8_t>(ml::ActFunc::Softmax) == actFunc);
+}
+} // namespace ml::model
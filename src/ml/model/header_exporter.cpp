@@ -0,0 +1,260 @@
+/**
+ * @brief Exporter writing models as generated C++ headers implementation
+ *        details.
+ */
+#include <stdio.h>
+
+#include <zephyr/sys/printk.h>
+
+#include "ml/dense_layer/kernels.hpp"
+#include "ml/model/header_exporter.hpp"
+#include "ml/model/writer.hpp"
+
+namespace ml::model {
+namespace {
+/** The number of values written per line. */
+constexpr size_t ValuesPerLine{4U};
+
+/** The number of integer levels written per line. */
+constexpr size_t LevelsPerLine{12U};
+
+/** Size of the formatting buffer. */
+constexpr size_t LineSize{128U};
+
+// -----------------------------------------------------------------------------
+bool isIdentifier(const char *name) noexcept {
+  if ((nullptr == name) || ('\0' == *name) ||
+      (('0' <= *name) && ('9' >= *name))) {
+    return false;
+  }
+  for (; '\0' != *name; ++name) {
+    const auto c{*name};
+
+    if (!((('a' <= c) && ('z' >= c)) || (('A' <= c) && ('Z' >= c)) ||
+          (('0' <= c) && ('9' >= c)) || ('_' == c))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+const char *actFuncName(const ml::ActFunc actFunc) noexcept {
+  switch (actFunc) {
+  case ml::ActFunc::Tanh:
+    return "Tanh";
+  case ml::ActFunc::Softmax:
+    return "Softmax";
+  default:
+    return "Relu";
+  }
+}
+
+/** Formats text into a line buffer and forwards it to the sink. */
+class Writer final {
+public:
+  Writer(TextSink sink, void *context, const ScalarType scalarType) noexcept
+      : mySink{sink}, myContext{context}, myScalarType{scalarType},
+        myLine{}, myCount{} {}
+
+  template <typename... Args>
+  void print(const char *format, Args... args) noexcept {
+    snprintf(myLine, sizeof(myLine), format, args...);
+    mySink(myLine, myContext);
+  }
+
+  void value(const double value) noexcept {
+    // Enough digits to read back the exact same value.
+    if (ScalarType::Float32 == myScalarType) {
+      print("%s%.9gF,", prefix(), value);
+    } else {
+      print("%s%.17g,", prefix(), value);
+    }
+    endValue(ValuesPerLine);
+  }
+
+  void level(const int32_t level) noexcept {
+    print("%s%d,", prefix(), (int)level);
+    endValue(LevelsPerLine);
+  }
+
+  void endArray() noexcept {
+    print("%s};\n", 0U == myCount ? "" : "\n");
+    myCount = 0U;
+  }
+
+  const char *type() const noexcept {
+    return ScalarType::Float32 == myScalarType ? "float" : "double";
+  }
+
+private:
+  const char *prefix() const noexcept { return 0U == myCount ? "    " : " "; }
+
+  void endValue(const size_t perLine) noexcept {
+    if (perLine == ++myCount) {
+      print("\n");
+      myCount = 0U;
+    }
+  }
+
+  TextSink mySink;               ///< The receiver of the text.
+  void *myContext;               ///< Context passed on to the sink.
+  const ScalarType myScalarType; ///< The scalar type of the values.
+  char myLine[LineSize];         ///< Formatting buffer.
+  size_t myCount;                ///< The number of values on the line.
+};
+} // namespace
+
+// -----------------------------------------------------------------------------
+void printkSink(const char *text, void *) noexcept { printk("%s", text); }
+
+// -----------------------------------------------------------------------------
+bool exportHeader(const ml::dense_layer::Interface *const layers[],
+                  const size_t layerCount, const char *name,
+                  const ScalarType scalarType, TextSink sink,
+                  void *context) noexcept {
+  // The layers must be storable in the binary format as well.
+  if ((nullptr == sink) || !isIdentifier(name) ||
+      (0U == requiredBytes(layers, layerCount, scalarType))) {
+    printk("invalid model export parameters\n");
+    return false;
+  }
+  Writer writer{sink, context, scalarType};
+  size_t maxWidth{};
+
+  writer.print("/**\n * @brief Generated model %s, do not edit.\n */\n", name);
+  writer.print("#pragma once\n\n// clang-format off\n");
+  writer.print("#include \"ml/model/static_model.hpp\"\n\n");
+  writer.print("namespace ml::generated::%s {\n", name);
+
+  for (size_t l{}; l < layerCount; ++l) {
+    const auto &layer{*layers[l]};
+
+    writer.print("inline constexpr %s layer%uBias[]{\n", writer.type(),
+                 (unsigned)l);
+    for (const auto bias : layer.bias()) {
+      writer.value(bias);
+    }
+    writer.endArray();
+
+    writer.print("inline constexpr %s layer%uWeights[]{\n", writer.type(),
+                 (unsigned)l);
+    for (const auto &nodeWeights : layer.weights()) {
+      for (const auto weight : nodeWeights) {
+        writer.value(weight);
+      }
+    }
+    writer.endArray();
+
+    if (maxWidth < layer.nodeCount()) {
+      maxWidth = layer.nodeCount();
+    }
+  }
+
+  writer.print("inline constexpr ml::model::StaticLayer<%s> layers[]{\n",
+               writer.type());
+  for (size_t l{}; l < layerCount; ++l) {
+    const auto &layer{*layers[l]};
+    writer.print("    {layer%uBias, layer%uWeights, %uU, %uU, "
+                 "ml::ActFunc::%s},\n",
+                 (unsigned)l, (unsigned)l, (unsigned)layer.nodeCount(),
+                 (unsigned)layer.weightCount(), actFuncName(layer.actFunc()));
+  }
+  writer.print("};\n");
+  writer.print("inline constexpr ml::model::StaticModel<%s, %uU, %uU> "
+               "model{layers};\n\n",
+               writer.type(), (unsigned)layerCount, (unsigned)maxWidth);
+  writer.print("inline void predict(const double *input, double *output) "
+               "noexcept {\n  model.predict(input, output);\n}\n");
+  writer.print("} // namespace ml::generated::%s\n// clang-format on\n", name);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool exportQuantizedHeader(const ml::dense_layer::DenseLayer *const layers[],
+                           const size_t layerCount, const char *name,
+                           TextSink sink, void *context) noexcept {
+  using ml::dense_layer::quantizeLevel;
+  using ml::dense_layer::quantMax;
+  bool isValid{(nullptr != sink) && isIdentifier(name) &&
+               (nullptr != layers) && (0U < layerCount) &&
+               (MaxLayerCount >= layerCount)};
+
+  for (size_t l{}; isValid && (l < layerCount); ++l) {
+    // Every layer must be fake-quantized, calibrated and feed the next one.
+    // An input scale of 0 would quantize every input to level 0.
+    isValid = (nullptr != layers[l]) &&
+              (ml::Quantization::None != layers[l]->quantization()) &&
+              (0.0 < layers[l]->inputScale()) &&
+              ((0U == l) ||
+               (layers[l - 1U]->nodeCount() == layers[l]->weightCount()));
+  }
+  if (!isValid) {
+    printk("invalid quantized model export parameters\n");
+    return false;
+  }
+  Writer writer{sink, context, ScalarType::Float32};
+  size_t maxWidth{};
+
+  writer.print("/**\n * @brief Generated quantized model %s, do not edit.\n"
+               " */\n",
+               name);
+  writer.print("#pragma once\n\n// clang-format off\n");
+  writer.print("#include <stdint.h>\n\n");
+  writer.print("#include \"ml/model/static_model.hpp\"\n\n");
+  writer.print("namespace ml::generated::%s {\n", name);
+
+  for (size_t l{}; l < layerCount; ++l) {
+    const auto &layer{*layers[l]};
+    const auto max{quantMax(layer.quantization())};
+
+    writer.print("inline constexpr int8_t layer%uWeights[]{\n", (unsigned)l);
+    for (size_t i{}; i < layer.nodeCount(); ++i) {
+      for (const auto weight : layer.weights()[i]) {
+        writer.level(quantizeLevel(weight, layer.weightScales()[i], max));
+      }
+    }
+    writer.endArray();
+
+    writer.print("inline constexpr float layer%uWeightScales[]{\n",
+                 (unsigned)l);
+    for (const auto scale : layer.weightScales()) {
+      writer.value(scale);
+    }
+    writer.endArray();
+
+    writer.print("inline constexpr float layer%uBias[]{\n", (unsigned)l);
+    for (const auto bias : layer.bias()) {
+      writer.value(bias);
+    }
+    writer.endArray();
+
+    // The input levels need a buffer as wide as the widest input.
+    if (maxWidth < layer.nodeCount()) {
+      maxWidth = layer.nodeCount();
+    }
+    if (maxWidth < layer.weightCount()) {
+      maxWidth = layer.weightCount();
+    }
+  }
+
+  writer.print("inline constexpr ml::model::StaticQuantLayer layers[]{\n");
+  for (size_t l{}; l < layerCount; ++l) {
+    const auto &layer{*layers[l]};
+    writer.print("    {layer%uWeights, layer%uWeightScales, layer%uBias, "
+                 "%.9gF, %d, %uU, %uU, ml::ActFunc::%s},\n",
+                 (unsigned)l, (unsigned)l, (unsigned)l, layer.inputScale(),
+                 (int)quantMax(layer.quantization()),
+                 (unsigned)layer.nodeCount(), (unsigned)layer.weightCount(),
+                 actFuncName(layer.actFunc()));
+  }
+  writer.print("};\n");
+  writer.print("inline constexpr ml::model::StaticQuantModel<%uU, %uU> "
+               "model{layers};\n\n",
+               (unsigned)layerCount, (unsigned)maxWidth);
+  writer.print("inline void predict(const double *input, double *output) "
+               "noexcept {\n  model.predict(input, output);\n}\n");
+  writer.print("} // namespace ml::generated::%s\n// clang-format on\n", name);
+  return true;
+}
+} // namespace ml::model
@@ -0,0 +1,73 @@
+/**
+ * @brief Exporter writing models as generated C++ headers.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/dense_layer/dense_layer.hpp"
+#include "ml/dense_layer/interface.hpp"
+#include "ml/model/format.hpp"
+
+namespace ml::model {
+/**
+ * @brief Receiver of generated text.
+ *
+ * @param[in] text The next piece of text, null-terminated.
+ * @param[in] context The context passed to the exporter.
+ */
+using TextSink = void (*)(const char *text, void *context);
+
+/**
+ * @brief Text sink printing to the console.
+ *
+ * @param[in] text The next piece of text, null-terminated.
+ * @param[in] context Unused.
+ */
+void printkSink(const char *text, void *context) noexcept;
+
+/**
+ * @brief Write the given layers as a C++ header of constexpr arrays.
+ *
+ *        The header defines namespace ml::generated::<name> holding the
+ *        parameters, a StaticModel named model and a predict() function.
+ *        Saved as src/ml/generated/<name>.hpp, it lets the application run
+ *        inference without any training code (see static_model.hpp).
+ *
+ * @param[in] layers The layers of the model, input layer first.
+ * @param[in] layerCount The number of layers, 1 - MaxLayerCount.
+ * @param[in] name The name of the model, a valid C++ identifier.
+ * @param[in] scalarType The scalar type to store the parameters as.
+ * @param[in] sink The receiver of the generated text.
+ * @param[in] context Context passed on to the sink (default = nullptr).
+ *
+ * @return True if the header was written, or false on error.
+ */
+bool exportHeader(const ml::dense_layer::Interface *const layers[],
+                  const size_t layerCount, const char *name,
+                  const ScalarType scalarType, TextSink sink,
+                  void *context = nullptr) noexcept;
+
+/**
+ * @brief Write the given fake-quantized layers as a C++ header of integer
+ *        weights.
+ *
+ *        Like exportHeader(), but the weights are stored as int8_t levels
+ *        with the per-node weight scales and the input scale learned during
+ *        training (see DenseLayer::setFakeQuant()), on top of a
+ *        StaticQuantModel. The weights take a quarter of the float size.
+ *
+ * @param[in] layers The layers of the model, input layer first. Fake
+ *                   quantization must be enabled in every layer, and
+ *                   DenseLayer::calibrate() must have set its input range.
+ * @param[in] layerCount The number of layers, 1 - MaxLayerCount.
+ * @param[in] name The name of the model, a valid C++ identifier.
+ * @param[in] sink The receiver of the generated text.
+ * @param[in] context Context passed on to the sink (default = nullptr).
+ *
+ * @return True if the header was written, or false on error.
+ */
+bool exportQuantizedHeader(const ml::dense_layer::DenseLayer *const layers[],
+                           const size_t layerCount, const char *name,
+                           TextSink sink, void *context = nullptr) noexcept;
+} // namespace ml::model
@@ -0,0 +1,101 @@
+/**
+ * @brief Memory-mapped model file implementation details.
+ */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <zephyr/sys/printk.h>
+
+#include "ml/model/mapped_file.hpp"
+
+namespace ml::model {
+namespace {
+// -----------------------------------------------------------------------------
+bool writeFile(const char *path, const int flags, const void *data,
+               const size_t size) noexcept {
+  const auto fd{::open(path, O_WRONLY | O_CREAT | flags, 0644)};
+  if (0 > fd) {
+    printk("failed to create %s\n", path);
+    return false;
+  }
+  const auto bytes{static_cast<const char *>(data)};
+  size_t written{};
+
+  while (written < size) {
+    const auto result{::write(fd, bytes + written, size - written)};
+
+    if (0 >= result) {
+      ::close(fd);
+      return false;
+    }
+    written += static_cast<size_t>(result);
+  }
+  return 0 == ::close(fd);
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+MappedFile::MappedFile() noexcept : myData{nullptr}, mySize{} {}
+
+// -----------------------------------------------------------------------------
+MappedFile::~MappedFile() noexcept { close(); }
+
+// -----------------------------------------------------------------------------
+bool MappedFile::open(const char *path) noexcept {
+  close();
+
+  const auto fd{::open(path, O_RDONLY)};
+  if (0 > fd) {
+    printk("failed to open %s\n", path);
+    return false;
+  }
+  struct stat info {};
+
+  if ((0 != fstat(fd, &info)) || (0 >= info.st_size)) {
+    ::close(fd);
+    return false;
+  }
+  const auto size{static_cast<size_t>(info.st_size)};
+  const auto data{mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0)};
+
+  // The mapping stays valid after the descriptor is closed.
+  ::close(fd);
+
+  if (MAP_FAILED == data) {
+    printk("failed to map %s\n", path);
+    return false;
+  }
+  myData = data;
+  mySize = size;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+void MappedFile::close() noexcept {
+  if (nullptr != myData) {
+    munmap(myData, mySize);
+    myData = nullptr;
+    mySize = 0U;
+  }
+}
+
+// -----------------------------------------------------------------------------
+const void *MappedFile::data() const noexcept { return myData; }
+
+// -----------------------------------------------------------------------------
+size_t MappedFile::size() const noexcept { return mySize; }
+
+// -----------------------------------------------------------------------------
+bool MappedFile::write(const char *path, const void *data,
+                       const size_t size) noexcept {
+  return writeFile(path, O_TRUNC, data, size);
+}
+
+// -----------------------------------------------------------------------------
+bool MappedFile::append(const char *path, const void *data,
+                        const size_t size) noexcept {
+  return writeFile(path, O_APPEND, data, size);
+}
+} // namespace ml::model
@@ -0,0 +1,95 @@
+/**
+ * @brief Memory-mapped model or dataset file, for builds running on a POSIX
+ *        host.
+ */
+#pragma once
+
+#include <stddef.h>
+
+namespace ml::model {
+/**
+ * @brief Read-only memory mapping of a model or dataset file.
+ *
+ *        The mapping is page aligned, so a ModelView or a DatasetView can use
+ *        it in place.
+ */
+class MappedFile final {
+public:
+  /**
+   * @brief Create a new mapping without a file.
+   */
+  MappedFile() noexcept;
+
+  /**
+   * @brief Delete the mapping, unmapping the file.
+   */
+  ~MappedFile() noexcept;
+
+  /**
+   * @brief Map the given file, unmapping the previous one.
+   *
+   * @param[in] path The path of the file to map.
+   *
+   * @return True if the file was mapped, or false on error.
+   */
+  bool open(const char *path) noexcept;
+
+  /**
+   * @brief Unmap the current file, if any.
+   */
+  void close() noexcept;
+
+  /**
+   * @brief Get the mapped bytes.
+   *
+   * @return The mapped bytes, or nullptr if no file is mapped.
+   */
+  const void *data() const noexcept;
+
+  /**
+   * @brief Get the size of the mapped file.
+   *
+   * @return The size in bytes, or 0 if no file is mapped.
+   */
+  size_t size() const noexcept;
+
+  /**
+   * @brief Write the given bytes to a file, replacing its content.
+   *
+   * @param[in] path The path of the file to write.
+   * @param[in] data The bytes to write.
+   * @param[in] size The number of bytes to write.
+   *
+   * @return True if the file was written, or false on error.
+   */
+  static bool write(const char *path, const void *data,
+                    const size_t size) noexcept;
+
+  /**
+   * @brief Append the given bytes to a file, creating it if needed.
+   *
+   *        Lets a logger grow a dataset file sample by sample (see
+   *        ml/dataset/format.hpp).
+   *
+   * @param[in] path The path of the file to append to.
+   * @param[in] data The bytes to append.
+   * @param[in] size The number of bytes to append.
+   *
+   * @return True if the bytes were appended, or false on error.
+   */
+  static bool append(const char *path, const void *data,
+                     const size_t size) noexcept;
+
+  MappedFile(const MappedFile &) = delete;            // No copy constructor.
+  MappedFile(MappedFile &&) = delete;                 // No move constructor.
+  MappedFile &operator=(const MappedFile &) = delete; // No copy assignment.
+  MappedFile &operator=(MappedFile &&) = delete;      // No move assignment.
+
+private:
+  /** The mapped bytes, nullptr if no file is mapped. */
+  void *myData;
+
+  /** The size of the mapping in bytes. */
+  size_t mySize;
+};
+} // namespace ml::model
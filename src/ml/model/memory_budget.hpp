@@ -0,0 +1,212 @@
+/**
+ * @brief Compile-time heap budget of a layer stack.
+ *
+ *        The heap use of the dense layers is fully determined by their
+ *        dimensions, the optimizer and the batch size, so it can be planned
+ *        and checked against the heap size before anything is allocated:
+ *
+ *        constexpr size_t widths[]{3U, 8U, 8U};
+ *        static_assert(memoryBudget(widths, 3U, ScalarType::Float32,
+ *                                   ml::Optimizer::None, 1U)
+ *                              .peakBytes() <= CONFIG_HEAP_MEM_POOL_SIZE,
+ *                      "the layers don't fit the heap");
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ml/model/format.hpp"
+#include "ml/types.hpp"
+
+namespace ml::model {
+/**
+ * Bytes the heap adds in front of every block. The Zephyr system heap keeps a
+ * 4-byte chunk header (heaps below 256 KB) and k_malloc() a 4-byte reference
+ * to the heap.
+ */
+constexpr size_t HeapHeaderBytes{8U};
+
+/** The heap hands out blocks in multiples of this many bytes. */
+constexpr size_t HeapUnitBytes{8U};
+
+/**
+ * @brief Planned heap use of a layer stack, in bytes.
+ *
+ *        Every field includes the block overhead of the heap and the vector
+ *        objects stored in the row blocks of a matrix.
+ */
+struct MemoryBudget {
+  size_t weights;      ///< Weights and biases.
+  size_t activations;  ///< Layer outputs and batch buffers.
+  size_t gradients;    ///< Errors, active node lists and gradients.
+  size_t optimizer;    ///< Optimizer state.
+  size_t quantization; ///< Fake quantization buffers.
+  size_t transient;    ///< Temporary row alive while a layer is created.
+  size_t model;        ///< Stored model in the scalar type, not on the heap.
+
+  /**
+   * @brief Get the heap use once all layers are set up.
+   *
+   * @return The number of bytes.
+   */
+  constexpr size_t heapBytes() const noexcept {
+    return weights + activations + gradients + optimizer + quantization;
+  }
+
+  /**
+   * @brief Get the highest heap use, including the temporary block.
+   *
+   *        Heap fragmentation isn't included, keep some headroom.
+   *
+   * @return The number of bytes, an upper bound.
+   */
+  constexpr size_t peakBytes() const noexcept {
+    return heapBytes() + transient;
+  }
+};
+
+/**
+ * @brief Get the heap size of one block.
+ *
+ * @param[in] size The number of bytes requested.
+ *
+ * @return The number of bytes taken from the heap, 0 for no block.
+ */
+constexpr size_t heapBlockBytes(const size_t size) noexcept {
+  return 0U == size ? 0U
+                    : (HeapHeaderBytes + size + HeapUnitBytes - 1U) /
+                          HeapUnitBytes * HeapUnitBytes;
+}
+
+/**
+ * @brief Get the heap size of a vector.
+ *
+ * @tparam T The value type of the vector.
+ *
+ * @param[in] size The number of values in the vector.
+ *
+ * @return The number of bytes taken from the heap.
+ */
+template <typename T> constexpr size_t vectorBytes(const size_t size) noexcept {
+  return heapBlockBytes(size * sizeof(T));
+}
+
+/**
+ * @brief Get the heap size of a matrix.
+ *
+ *        A matrix is one block of row vectors, prefixed with the element
+ *        count new[] keeps for types with a destructor, and one block per
+ *        row.
+ *
+ * @param[in] rowCount The number of rows.
+ * @param[in] columnCount The number of values per row.
+ *
+ * @return The number of bytes taken from the heap.
+ */
+constexpr size_t matrixBytes(const size_t rowCount,
+                             const size_t columnCount) noexcept {
+  constexpr size_t countBytes{alignof(ml::Matrix1d) < sizeof(size_t)
+                                  ? sizeof(size_t)
+                                  : alignof(ml::Matrix1d)};
+  const size_t rowsBytes{
+      0U == rowCount
+          ? 0U
+          : heapBlockBytes(countBytes + rowCount * sizeof(ml::Matrix1d))};
+  return rowsBytes + rowCount * vectorBytes<double>(columnCount);
+}
+
+/**
+ * @brief Get the number of weight and bias sets of an optimizer's state.
+ *
+ * @param[in] optimizer The optimizer.
+ *
+ * @return The number of state values per parameter.
+ */
+constexpr size_t optimizerStateCount(const ml::Optimizer optimizer) noexcept {
+  switch (optimizer) {
+  case ml::Optimizer::Momentum:
+  case ml::Optimizer::RmsProp:
+    return 1U;
+  case ml::Optimizer::Adam:
+    return 2U;
+  default:
+    return 0U;
+  }
+}
+
+/**
+ * @brief Plan the heap use of training a stack of dense layers.
+ *
+ *        Mirrors the allocations of ml::dense_layer::DenseLayer, its
+ *        optimizer and the batch buffers of the trainer. With fake
+ *        quantization, the quantized weights, weight scales and quantized
+ *        inputs are included, and so are the gradient buffers optimize()
+ *        keeps afterwards.
+ *
+ * @param[in] widths The output width of every layer, input layer first.
+ * @param[in] layerCount The number of layers, including the input layer.
+ * @param[in] scalarType The scalar type the model is stored as.
+ * @param[in] optimizer The optimizer attached to every layer.
+ * @param[in] batchSize The number of samples per update.
+ * @param[in] quantization The fake quantization trained with, None
+ *                         (default) if unused.
+ *
+ * @return The planned heap use.
+ */
+constexpr MemoryBudget memoryBudget(const size_t widths[],
+                                    const size_t layerCount,
+                                    const ScalarType scalarType,
+                                    const ml::Optimizer optimizer,
+                                    const size_t batchSize,
+                                    const ml::Quantization quantization =
+                                        ml::Quantization::None) noexcept {
+  const bool batched{1U < batchSize};
+  const bool quantized{ml::Quantization::None != quantization};
+  const bool hasGradient{batched || quantized ||
+                         (ml::Optimizer::None != optimizer)};
+  const size_t stateCount{optimizerStateCount(optimizer)};
+  MemoryBudget budget{};
+
+  if (1U < layerCount) {
+    budget.model = sizeof(Header);
+  }
+  if (batched) {
+    budget.activations += matrixBytes(batchSize, widths[0U]) +
+                          matrixBytes(batchSize, widths[layerCount - 1U]);
+  }
+
+  for (size_t i{1U}; i < layerCount; ++i) {
+    const size_t nodeCount{widths[i]};
+    const size_t weightCount{widths[i - 1U]};
+    const size_t parameterBytes{matrixBytes(nodeCount, weightCount) +
+                                vectorBytes<double>(nodeCount)};
+
+    budget.weights += parameterBytes;
+    budget.activations += vectorBytes<double>(nodeCount);
+    budget.gradients += vectorBytes<double>(nodeCount) +
+                        vectorBytes<uint32_t>(nodeCount);
+    budget.optimizer += stateCount * parameterBytes;
+    budget.model += layerBytes(nodeCount, weightCount, scalarType);
+
+    if (hasGradient) {
+      budget.gradients += parameterBytes;
+    }
+    if (quantized) {
+      budget.quantization += matrixBytes(nodeCount, weightCount) +
+                             vectorBytes<double>(nodeCount) +
+                             vectorBytes<double>(weightCount);
+    }
+    if (batched) {
+      budget.activations += matrixBytes(batchSize, nodeCount);
+      budget.gradients += matrixBytes(batchSize, nodeCount);
+    }
+    // Every weight row is first built as a temporary and then copied.
+    const size_t rowBytes{vectorBytes<double>(weightCount)};
+    if (budget.transient < rowBytes) {
+      budget.transient = rowBytes;
+    }
+  }
+  return budget;
+}
+} // namespace ml::model
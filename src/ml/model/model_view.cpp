@@ -0,0 +1,182 @@
+/**
+ * @brief In-place view of a binary model implementation details.
+ */
+#include <stdint.h>
+
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/printk.h>
+
+#include "ml/dense_layer/kernels.hpp"
+#include "ml/model/model_view.hpp"
+
+namespace ml::model {
+// -----------------------------------------------------------------------------
+ModelView::ModelView() noexcept
+    : myLayers{}, myLayerCount{}, myScalarType{ScalarType::Float64},
+      myOwnArena{}, myArena{myOwnArena}, myActivationSize{}, myOutput{} {}
+
+// -----------------------------------------------------------------------------
+ModelView::ModelView(ActivationArena &arena) noexcept
+    : myLayers{}, myLayerCount{}, myScalarType{ScalarType::Float64},
+      myOwnArena{}, myArena{arena}, myActivationSize{}, myOutput{} {}
+
+// -----------------------------------------------------------------------------
+bool ModelView::load(const void *data, const size_t size) noexcept {
+  myLayerCount = 0U;
+
+  if ((nullptr == data) || (sizeof(Header) > size) ||
+      (0U != reinterpret_cast<uintptr_t>(data) % Alignment)) {
+    printk("invalid model location\n");
+    return false;
+  }
+  const auto bytes{static_cast<const uint8_t *>(data)};
+  const auto &header{*static_cast<const Header *>(data)};
+
+  if ((Magic != header.magic) || (Version != header.version) ||
+      (size < header.size) || (sizeof(Header) > header.size) ||
+      (0U == header.layerCount) || (MaxLayerCount < header.layerCount) ||
+      (static_cast<uint8_t>(ScalarType::Float32) < header.scalarType)) {
+    printk("invalid model header\n");
+    return false;
+  }
+  if (header.crc !=
+      crc32_ieee(bytes + sizeof(Header), header.size - sizeof(Header))) {
+    printk("model checksum mismatch\n");
+    return false;
+  }
+  const auto scalarType{static_cast<ScalarType>(header.scalarType)};
+  auto offset{sizeof(Header)};
+  size_t widths[MaxLayerCount]{};
+
+  for (size_t i{}; i < header.layerCount; ++i) {
+    if (header.size < offset + sizeof(LayerHeader)) {
+      printk("truncated model\n");
+      return false;
+    }
+    const auto &layerHeader{
+        *reinterpret_cast<const LayerHeader *>(bytes + offset)};
+    const auto blockSize{layerBytes(layerHeader.nodeCount,
+                                    layerHeader.weightCount, scalarType)};
+
+    // Consecutive layers must connect, and the block must fit.
+    if ((0U == layerHeader.nodeCount) || (0U == layerHeader.weightCount) ||
+        !isValidActFunc(layerHeader.actFunc) ||
+        ((0U < i) && (myLayers[i - 1U].header->nodeCount !=
+                      layerHeader.weightCount)) ||
+        (header.size < offset + blockSize)) {
+      printk("invalid model layer %u\n", (unsigned)i);
+      return false;
+    }
+    const auto values{bytes + offset + sizeof(LayerHeader)};
+    myLayers[i].header = &layerHeader;
+    myLayers[i].bias = values;
+    myLayers[i].weights =
+        values + layerHeader.nodeCount * scalarSize(scalarType);
+
+    widths[i] = layerHeader.nodeCount;
+    offset += blockSize;
+  }
+
+  // Only the activations are allocated. The hidden ones are planned into the
+  // arena, the last layer writes the output.
+  const auto hiddenCount{header.layerCount - 1U};
+  const auto activationCount{ml::model::activationSize(widths, hiddenCount)};
+
+  for (size_t i{}; i < hiddenCount; ++i) {
+    myLayers[i].offset = activationOffset(widths, i, activationCount);
+  }
+  if (!myArena.reserve(activationCount) ||
+      !ml::dense_layer::resizeZero(myOutput, widths[hiddenCount])) {
+    printk("failed to allocate model buffers\n");
+    return false;
+  }
+  myActivationSize = activationCount;
+  myScalarType = scalarType;
+  myLayerCount = header.layerCount;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool ModelView::isLoaded() const noexcept { return 0U < myLayerCount; }
+
+// -----------------------------------------------------------------------------
+size_t ModelView::layerCount() const noexcept { return myLayerCount; }
+
+// -----------------------------------------------------------------------------
+size_t ModelView::inputCount() const noexcept {
+  return isLoaded() ? myLayers[0U].header->weightCount : 0U;
+}
+
+// -----------------------------------------------------------------------------
+size_t ModelView::outputCount() const noexcept {
+  return isLoaded() ? myLayers[myLayerCount - 1U].header->nodeCount : 0U;
+}
+
+// -----------------------------------------------------------------------------
+size_t ModelView::activationSize() const noexcept { return myActivationSize; }
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &ModelView::predict(const ml::Matrix1d &input) noexcept {
+  if (!isLoaded() || (input.size() != inputCount())) {
+    static const ml::Matrix1d empty{};
+    return empty;
+  }
+  // A shared arena may have moved since the model was loaded.
+  run(myArena.data(), input.data(), &myOutput[0U]);
+  return myOutput;
+}
+
+// -----------------------------------------------------------------------------
+bool ModelView::predict(ActivationArena &arena, const ml::Matrix1d &input,
+                        ml::Matrix1d &output) const noexcept {
+  if (!isLoaded() || (input.size() != inputCount()) ||
+      (output.size() < outputCount()) || !arena.reserve(myActivationSize)) {
+    return false;
+  }
+  run(arena.data(), input.data(), &output[0U]);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+void ModelView::run(double *arena, const double *input,
+                    double *output) const noexcept {
+  const double *layerInput{input};
+
+  for (size_t i{}; i < myLayerCount; ++i) {
+    // The last layer writes the output, the others their arena slot.
+    const auto layerOutput{i + 1U == myLayerCount ? output
+                                                  : arena + myLayers[i].offset};
+
+    if (ScalarType::Float32 == myScalarType) {
+      forward<float>(myLayers[i], layerInput, layerOutput);
+    } else {
+      forward<double>(myLayers[i], layerInput, layerOutput);
+    }
+    layerInput = layerOutput;
+  }
+}
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void ModelView::forward(const Layer &layer, const double *input,
+                        double *output) const noexcept {
+  const auto bias{static_cast<const T *>(layer.bias)};
+  const auto actFunc{static_cast<ml::ActFunc>(layer.header->actFunc)};
+  const size_t weightCount{layer.header->weightCount};
+  auto weights{static_cast<const T *>(layer.weights)};
+
+  for (size_t i{}; i < layer.header->nodeCount; ++i) {
+    // Start with the bias and add up all the weighted inputs.
+    double sum{bias[i]};
+
+    for (size_t j{}; j < weightCount; ++j) {
+      sum += input[j] * weights[j];
+    }
+    output[i] = ml::dense_layer::actFuncOutput(actFunc, sum);
+    weights += weightCount;
+  }
+  if (ml::ActFunc::Softmax == actFunc) {
+    ml::dense_layer::softmax(output, layer.header->nodeCount);
+  }
+}
+} // namespace ml::model
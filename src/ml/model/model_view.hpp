@@ -0,0 +1,167 @@
+/**
+ * @brief In-place view of a binary model.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/model/activation_arena.hpp"
+#include "ml/model/format.hpp"
+#include "ml/neural_network/interface.hpp"
+#include "ml/types.hpp"
+
+namespace ml::model {
+/**
+ * @brief In-place view of a binary model.
+ *
+ *        The view validates a model and predicts straight from its bytes, the
+ *        weights are never copied. The bytes may live anywhere the CPU can
+ *        read, e.g. a memory-mapped file or a memory-mapped flash partition,
+ *        and must outlive the view.
+ *
+ *        The hidden activations live in an activation arena, which holds
+ *        the widest pair of adjacent layers (see activationSize()). Views
+ *        predicting one after another can share one arena. Callers
+ *        predicting concurrently pass their own arena to predict() instead.
+ */
+class ModelView final : public ml::neural_network::Interface {
+public:
+  /**
+   * @brief Create a new view without a model, with its own arena.
+   */
+  ModelView() noexcept;
+
+  /**
+   * @brief Create a new view without a model, sharing the given arena.
+   *
+   * @param[in] arena The arena holding the hidden activations, must outlive
+   *                  the view. Views sharing it must not predict
+   *                  concurrently.
+   */
+  explicit ModelView(ActivationArena &arena) noexcept;
+
+  /**
+   * @brief Delete the view.
+   */
+  ~ModelView() noexcept override = default;
+
+  /**
+   * @brief Validate the given bytes and use them as model.
+   *
+   *        The magic, version, size, CRC and layer dimensions are checked.
+   *        On failure, the view holds no model.
+   *
+   * @param[in] data The model bytes, must be 8-byte aligned.
+   * @param[in] size The number of available bytes.
+   *
+   * @return True if the model was loaded, or false on error.
+   */
+  bool load(const void *data, const size_t size) noexcept;
+
+  /**
+   * @brief Check whether the view holds a model.
+   *
+   * @return True if a model is loaded, or false if not.
+   */
+  bool isLoaded() const noexcept;
+
+  /**
+   * @brief Get the number of layers in the model.
+   *
+   * @return The number of layers, or 0 if no model is loaded.
+   */
+  size_t layerCount() const noexcept;
+
+  /**
+   * @brief Get the number of inputs of the model.
+   *
+   * @return The number of inputs, or 0 if no model is loaded.
+   */
+  size_t inputCount() const noexcept;
+
+  /**
+   * @brief Get the number of outputs of the model.
+   *
+   * @return The number of outputs, or 0 if no model is loaded.
+   */
+  size_t outputCount() const noexcept;
+
+  /**
+   * @brief Get the number of arena values the model needs.
+   *
+   * @return The number of values, 0 if no model is loaded or the model has
+   *         a single layer.
+   */
+  size_t activationSize() const noexcept;
+
+  /**
+   * @brief Predict the output for the given input.
+   *
+   * @param[in] input Input values, must hold inputCount() values.
+   *
+   * @return Output values, empty if no model is loaded or the input doesn't
+   *         match.
+   */
+  const ml::Matrix1d &predict(const ml::Matrix1d &input) noexcept override;
+
+  /**
+   * @brief Predict the output for the given input, reentrant.
+   *
+   *        The model is only read, the activations live in the given arena.
+   *        Any number of callers can predict concurrently, each with its own
+   *        arena.
+   *
+   * @param[in, out] arena The caller's arena, grows to activationSize()
+   *                       values on first use.
+   * @param[in] input Input values, must hold inputCount() values.
+   * @param[out] output Output values, must hold outputCount() values.
+   *
+   * @return True if the output was predicted, or false if no model is
+   *         loaded, the sizes don't match or on allocation failure.
+   */
+  bool predict(ActivationArena &arena, const ml::Matrix1d &input,
+               ml::Matrix1d &output) const noexcept;
+
+  ModelView(const ModelView &) = delete;            // No copy constructor.
+  ModelView(ModelView &&) = delete;                 // No move constructor.
+  ModelView &operator=(const ModelView &) = delete; // No copy assignment.
+  ModelView &operator=(ModelView &&) = delete;      // No move assignment.
+
+private:
+  /** Location of a layer within the model bytes. */
+  struct Layer {
+    const LayerHeader *header; ///< Dimensions and activation function.
+    const void *bias;          ///< Bias values, [node].
+    const void *weights;       ///< Weights, [node][weight].
+    size_t offset;             ///< Position of the output in the arena.
+  };
+
+  void run(double *arena, const double *input,
+           double *output) const noexcept;
+
+  template <typename T>
+  void forward(const Layer &layer, const double *input,
+               double *output) const noexcept;
+
+  /** The layers of the model, input layer first. */
+  Layer myLayers[MaxLayerCount];
+
+  /** The number of layers in the model, 0 if no model is loaded. */
+  size_t myLayerCount;
+
+  /** The scalar type of the parameters. */
+  ScalarType myScalarType;
+
+  /** The arena used when none is shared. */
+  ActivationArena myOwnArena;
+
+  /** The arena holding the hidden activations. */
+  ActivationArena &myArena;
+
+  /** The number of arena values the model needs. */
+  size_t myActivationSize;
+
+  /** The output of the last prediction. */
+  ml::Matrix1d myOutput;
+};
+} // namespace ml::model
@@ -0,0 +1,231 @@
+/**
+ * @brief Model stored as constant arrays.
+ *
+ *        Generated model headers (see header_exporter.hpp) define their
+ *        parameters as constexpr arrays and a StaticModel on top of them.
+ *        Everything lives in read-only data, so inference needs no heap, no
+ *        initialization and runs straight from flash.
+ */
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ml/dense_layer/kernels.hpp"
+#include "ml/types.hpp"
+
+namespace ml::model {
+/**
+ * @brief Layer stored as constant arrays.
+ *
+ * @tparam T The scalar type of the parameters.
+ */
+template <typename T> struct StaticLayer {
+  const T *bias;       ///< Bias values, [node].
+  const T *weights;    ///< Weights, [node][weight].
+  size_t nodeCount;    ///< The number of nodes in the layer.
+  size_t weightCount;  ///< The number of weights per node in the layer.
+  ml::ActFunc actFunc; ///< The activation function of the layer.
+};
+
+/**
+ * @brief Model stored as constant arrays.
+ *
+ * @tparam T The scalar type of the parameters.
+ * @tparam LayerCount The number of layers.
+ * @tparam MaxWidth The number of nodes in the widest layer.
+ */
+template <typename T, size_t LayerCount, size_t MaxWidth>
+class StaticModel final {
+public:
+  static_assert(0U < LayerCount, "a model needs at least one layer");
+  static_assert(0U < MaxWidth, "a model needs at least one node");
+
+  /**
+   * @brief Create a new model on top of the given layers.
+   *
+   * @param[in] layers The layers of the model, input layer first.
+   */
+  explicit constexpr StaticModel(
+      const StaticLayer<T> (&layers)[LayerCount]) noexcept
+      : myLayers{layers} {}
+
+  /**
+   * @brief Get the number of inputs of the model.
+   *
+   * @return The number of inputs.
+   */
+  constexpr size_t inputCount() const noexcept {
+    return myLayers[0U].weightCount;
+  }
+
+  /**
+   * @brief Get the number of outputs of the model.
+   *
+   * @return The number of outputs.
+   */
+  constexpr size_t outputCount() const noexcept {
+    return myLayers[LayerCount - 1U].nodeCount;
+  }
+
+  /**
+   * @brief Predict the output for the given input.
+   *
+   *        The activations are kept on the stack, 2 * MaxWidth values.
+   *
+   * @param[in] input Input values, must hold inputCount() values.
+   * @param[out] output Output values, must hold outputCount() values.
+   */
+  void predict(const double *input, double *output) const noexcept {
+    double buffers[2U][MaxWidth];
+    const double *layerInput{input};
+
+    for (size_t l{}; l < LayerCount; ++l) {
+      const auto &layer{myLayers[l]};
+      auto layerOutput{l + 1U == LayerCount ? output : buffers[l % 2U]};
+      auto weights{layer.weights};
+
+      for (size_t i{}; i < layer.nodeCount; ++i) {
+        // Start with the bias and add up all the weighted inputs.
+        double sum{layer.bias[i]};
+
+        for (size_t j{}; j < layer.weightCount; ++j) {
+          sum += layerInput[j] * weights[j];
+        }
+        layerOutput[i] = ml::dense_layer::actFuncOutput(layer.actFunc, sum);
+        weights += layer.weightCount;
+      }
+      if (ml::ActFunc::Softmax == layer.actFunc) {
+        ml::dense_layer::softmax(layerOutput, layer.nodeCount);
+      }
+      layerInput = layerOutput;
+    }
+  }
+
+private:
+  /** The layers of the model, input layer first. */
+  const StaticLayer<T> *myLayers;
+};
+
+/**
+ * @brief Layer with integer weights stored as constant arrays.
+ */
+struct StaticQuantLayer {
+  const int8_t *weights;     ///< Weight levels, [node][weight].
+  const float *weightScales; ///< The value of one weight level, [node].
+  const float *bias;         ///< Bias values, [node].
+  float inputScale;          ///< The value of one input level.
+  int32_t maxLevel;          ///< The largest level of weights and inputs.
+  size_t nodeCount;          ///< The number of nodes in the layer.
+  size_t weightCount;        ///< The number of weights per node in the layer.
+  ml::ActFunc actFunc;       ///< The activation function of the layer.
+};
+
+/**
+ * @brief Model with integer weights stored as constant arrays.
+ *
+ *        Every layer rounds its input to integer levels and computes the
+ *        weighted sums as integer dot products. Only the bias and the
+ *        activation use floating point:
+ *
+ *        output[i] = f(bias[i] + weightScale[i] * inputScale *
+ *                      sum(weight[i][j] * input[j]))
+ *
+ *        The levels and scales come from fake quantization during training
+ *        (see DenseLayer::setFakeQuant()), so the model keeps its trained
+ *        accuracy.
+ *
+ * @tparam LayerCount The number of layers.
+ * @tparam MaxWidth The largest number of nodes or inputs of any layer.
+ */
+template <size_t LayerCount, size_t MaxWidth> class StaticQuantModel final {
+public:
+  static_assert(0U < LayerCount, "a model needs at least one layer");
+  static_assert(0U < MaxWidth, "a model needs at least one node");
+
+  /**
+   * @brief Create a new model on top of the given layers.
+   *
+   * @param[in] layers The layers of the model, input layer first.
+   */
+  explicit constexpr StaticQuantModel(
+      const StaticQuantLayer (&layers)[LayerCount]) noexcept
+      : myLayers{layers} {}
+
+  /**
+   * @brief Get the number of inputs of the model.
+   *
+   * @return The number of inputs.
+   */
+  constexpr size_t inputCount() const noexcept {
+    return myLayers[0U].weightCount;
+  }
+
+  /**
+   * @brief Get the number of outputs of the model.
+   *
+   * @return The number of outputs.
+   */
+  constexpr size_t outputCount() const noexcept {
+    return myLayers[LayerCount - 1U].nodeCount;
+  }
+
+  /**
+   * @brief Predict the output for the given input.
+   *
+   *        The activations are kept on the stack, 2 * MaxWidth values plus
+   *        MaxWidth input levels.
+   *
+   * @param[in] input Input values, must hold inputCount() values.
+   * @param[out] output Output values, must hold outputCount() values.
+   */
+  void predict(const double *input, double *output) const noexcept {
+    double buffers[2U][MaxWidth];
+    int8_t levels[MaxWidth];
+    const double *layerInput{input};
+
+    for (size_t l{}; l < LayerCount; ++l) {
+      const auto &layer{myLayers[l]};
+      auto layerOutput{l + 1U == LayerCount ? output : buffers[l % 2U]};
+      auto weights{layer.weights};
+
+      for (size_t j{}; j < layer.weightCount; ++j) {
+        levels[j] = level(layerInput[j], layer.inputScale, layer.maxLevel);
+      }
+      for (size_t i{}; i < layer.nodeCount; ++i) {
+        // Integer dot product, 8-bit products summed into 32 bits.
+        int32_t sum{};
+
+        for (size_t j{}; j < layer.weightCount; ++j) {
+          sum += static_cast<int32_t>(weights[j]) * levels[j];
+        }
+        const double scale{static_cast<double>(layer.weightScales[i]) *
+                           layer.inputScale};
+        layerOutput[i] = ml::dense_layer::actFuncOutput(
+            layer.actFunc, layer.bias[i] + scale * sum);
+        weights += layer.weightCount;
+      }
+      if (ml::ActFunc::Softmax == layer.actFunc) {
+        ml::dense_layer::softmax(layerOutput, layer.nodeCount);
+      }
+      layerInput = layerOutput;
+    }
+  }
+
+private:
+  static int8_t level(const double value, const double scale,
+                      const int32_t max) noexcept {
+    if (0.0 >= scale) {
+      return 0;
+    }
+    const auto rounded{round(value / scale)};
+    return static_cast<int8_t>(rounded >= max    ? max
+                               : rounded <= -max ? -max
+                                                 : rounded);
+  }
+
+  /** The layers of the model, input layer first. */
+  const StaticQuantLayer *myLayers;
+};
+} // namespace ml::model
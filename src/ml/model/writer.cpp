@@ -0,0 +1,103 @@
+/**
+ * @brief Binary model writer implementation details.
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/printk.h>
+
+#include "ml/model/writer.hpp"
+
+namespace ml::model {
+namespace {
+/** The largest node and weight count the format can hold. */
+constexpr size_t MaxDimension{UINT16_MAX};
+
+// -----------------------------------------------------------------------------
+template <typename T>
+void writeValues(const ml::dense_layer::Interface &layer,
+                 uint8_t *data) noexcept {
+  auto values{reinterpret_cast<T *>(data)};
+
+  for (const auto bias : layer.bias()) {
+    *values++ = static_cast<T>(bias);
+  }
+  for (const auto &nodeWeights : layer.weights()) {
+    for (const auto weight : nodeWeights) {
+      *values++ = static_cast<T>(weight);
+    }
+  }
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+size_t requiredBytes(const ml::dense_layer::Interface *const layers[],
+                     const size_t layerCount,
+                     const ScalarType scalarType) noexcept {
+  if ((nullptr == layers) || (0U == layerCount) ||
+      (MaxLayerCount < layerCount)) {
+    return 0U;
+  }
+  auto size{sizeof(Header)};
+
+  for (size_t i{}; i < layerCount; ++i) {
+    const auto &layer{*layers[i]};
+
+    // Consecutive layers must connect.
+    if ((MaxDimension < layer.nodeCount()) ||
+        (MaxDimension < layer.weightCount()) ||
+        ((0U < i) && (layers[i - 1U]->nodeCount() != layer.weightCount()))) {
+      return 0U;
+    }
+    size += layerBytes(layer.nodeCount(), layer.weightCount(), scalarType);
+  }
+  return size;
+}
+
+// -----------------------------------------------------------------------------
+size_t save(const ml::dense_layer::Interface *const layers[],
+            const size_t layerCount, const ScalarType scalarType, void *buffer,
+            const size_t size) noexcept {
+  const auto modelSize{requiredBytes(layers, layerCount, scalarType)};
+
+  if ((0U == modelSize) || (nullptr == buffer) || (size < modelSize) ||
+      (0U != reinterpret_cast<uintptr_t>(buffer) % Alignment)) {
+    printk("invalid model buffer: expected %u actual %u\n",
+           (unsigned)modelSize, (unsigned)size);
+    return 0U;
+  }
+  auto data{static_cast<uint8_t *>(buffer)};
+
+  // Clear the buffer first, so padding and reserved bytes are zero.
+  memset(data, 0, modelSize);
+
+  auto position{data + sizeof(Header)};
+
+  for (size_t i{}; i < layerCount; ++i) {
+    const auto &layer{*layers[i]};
+    auto &layerHeader{*reinterpret_cast<LayerHeader *>(position)};
+    const auto values{position + sizeof(LayerHeader)};
+
+    layerHeader.nodeCount = static_cast<uint16_t>(layer.nodeCount());
+    layerHeader.weightCount = static_cast<uint16_t>(layer.weightCount());
+    layerHeader.actFunc = static_cast<uint8_t>(layer.actFunc());
+
+    if (ScalarType::Float32 == scalarType) {
+      writeValues<float>(layer, values);
+    } else {
+      writeValues<double>(layer, values);
+    }
+    position += layerBytes(layer.nodeCount(), layer.weightCount(), scalarType);
+  }
+
+  auto &header{*reinterpret_cast<Header *>(data)};
+  header.magic = Magic;
+  header.version = Version;
+  header.scalarType = static_cast<uint8_t>(scalarType);
+  header.layerCount = static_cast<uint8_t>(layerCount);
+  header.size = static_cast<uint32_t>(modelSize);
+  header.crc = crc32_ieee(data + sizeof(Header), modelSize - sizeof(Header));
+  return modelSize;
+}
+} // namespace ml::model
@@ -0,0 +1,43 @@
+/**
+ * @brief Binary model writer.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/dense_layer/interface.hpp"
+#include "ml/model/format.hpp"
+
+namespace ml::model {
+/**
+ * @brief Get the size of a model holding the given layers.
+ *
+ * @param[in] layers The layers of the model, input layer first.
+ * @param[in] layerCount The number of layers, 1 - MaxLayerCount.
+ * @param[in] scalarType The scalar type to store the parameters as.
+ *
+ * @return The size of the model in bytes, or 0 if the layers can't be
+ *         stored.
+ */
+size_t requiredBytes(const ml::dense_layer::Interface *const layers[],
+                     const size_t layerCount,
+                     const ScalarType scalarType) noexcept;
+
+/**
+ * @brief Write the given layers as a model.
+ *
+ *        For a single layer network, pass the hidden and output layer.
+ *
+ * @param[in] layers The layers of the model, input layer first.
+ * @param[in] layerCount The number of layers, 1 - MaxLayerCount.
+ * @param[in] scalarType The scalar type to store the parameters as.
+ * @param[out] buffer The buffer to write the model to, must be 8-byte
+ *                    aligned.
+ * @param[in] size The size of the buffer in bytes.
+ *
+ * @return The number of bytes written, or 0 on error.
+ */
+size_t save(const ml::dense_layer::Interface *const layers[],
+            const size_t layerCount, const ScalarType scalarType, void *buffer,
+            const size_t size) noexcept;
+} // namespace ml::model
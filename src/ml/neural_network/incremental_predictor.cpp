@@ -0,0 +1,104 @@
+/**
+ * @brief Incremental inference implementation details.
+ */
+#include <zephyr/sys/printk.h>
+
+#include "ml/dense_layer/kernels.hpp"
+#include "ml/neural_network/incremental_predictor.hpp"
+
+namespace ml::neural_network {
+// -----------------------------------------------------------------------------
+IncrementalPredictor::IncrementalPredictor(
+    const ml::dense_layer::Interface &hiddenLayer,
+    const ml::dense_layer::Interface &outputLayer, const size_t refreshInterval)
+    : myHiddenLayer{hiddenLayer}, myOutputLayer{outputLayer},
+      myRefreshInterval{refreshInterval}, myInput{}, mySums{}, myHiddenOutput{},
+      myOutput{}, myUpdateCount{}, myValid{false} {
+  using ml::dense_layer::resizeZero;
+
+  // Make sure the layers connect properly.
+  if (hiddenLayer.nodeCount() != outputLayer.weightCount()) {
+    printk("invalid incremental predictor parameters\n");
+    while (1) {
+    }
+  }
+  if (!resizeZero(myInput, hiddenLayer.weightCount()) ||
+      !resizeZero(mySums, hiddenLayer.nodeCount()) ||
+      !resizeZero(myHiddenOutput, hiddenLayer.nodeCount()) ||
+      !resizeZero(myOutput, outputLayer.nodeCount())) {
+    printk("failed to allocate incremental predictor buffers\n");
+    while (1) {
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &
+IncrementalPredictor::predict(const ml::Matrix1d &input) noexcept {
+  if (input.size() != myInput.size()) {
+    static const ml::Matrix1d empty{};
+    return empty;
+  }
+  size_t changedCount{};
+
+  for (size_t j{}; j < input.size(); ++j) {
+    if (input[j] != myInput[j]) {
+      ++changedCount;
+    }
+  }
+
+  if (!myValid || (myRefreshInterval <= myUpdateCount) ||
+      (2U * changedCount > input.size())) {
+    recompute(input);
+  } else if (0U < changedCount) {
+    const auto &weights{myHiddenLayer.weights()};
+
+    // Only walk the weight columns of the changed inputs.
+    for (size_t j{}; j < input.size(); ++j) {
+      const auto delta{input[j] - myInput[j]};
+
+      if (0.0 == delta) {
+        continue;
+      }
+      for (size_t i{}; i < mySums.size(); ++i) {
+        mySums[i] += weights[i][j] * delta;
+      }
+      myInput[j] = input[j];
+    }
+    ++myUpdateCount;
+  }
+
+  // The output layer is small, it's always computed in full.
+  const auto actFunc{myHiddenLayer.actFunc()};
+
+  for (size_t i{}; i < mySums.size(); ++i) {
+    myHiddenOutput[i] = ml::dense_layer::actFuncOutput(actFunc, mySums[i]);
+  }
+  ml::dense_layer::forward(myOutputLayer, myHiddenOutput, myOutput);
+  return myOutput;
+}
+
+// -----------------------------------------------------------------------------
+void IncrementalPredictor::reset() noexcept { myValid = false; }
+
+// -----------------------------------------------------------------------------
+void IncrementalPredictor::recompute(const ml::Matrix1d &input) noexcept {
+  const auto &weights{myHiddenLayer.weights()};
+  const auto &bias{myHiddenLayer.bias()};
+
+  for (size_t i{}; i < mySums.size(); ++i) {
+    // Start with the bias and add up all the weighted inputs.
+    auto sum{bias[i]};
+
+    for (size_t j{}; j < input.size(); ++j) {
+      sum += input[j] * weights[i][j];
+    }
+    mySums[i] = sum;
+  }
+  for (size_t j{}; j < input.size(); ++j) {
+    myInput[j] = input[j];
+  }
+  myUpdateCount = 0U;
+  myValid = true;
+}
+} // namespace ml::neural_network
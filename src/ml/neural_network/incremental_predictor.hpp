@@ -0,0 +1,100 @@
+/**
+ * @brief Incremental inference for single layer neural networks.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/dense_layer/interface.hpp"
+#include "ml/neural_network/interface.hpp"
+#include "ml/types.hpp"
+
+namespace ml::neural_network {
+/**
+ * @brief Incremental inference for single layer neural networks.
+ *
+ *        Keeps the weighted sums of the hidden layer from the last
+ *        prediction. When only a few inputs change, only their contribution
+ *        is updated:
+ *
+ *        sum[i] += weight[i][j] * (new_input[j] - old_input[j])
+ *
+ *        which costs O(changed inputs * nodes) instead of O(inputs * nodes).
+ *        To bound floating-point drift, the sums are recomputed from scratch
+ *        every refresh interval predictions, and whenever more than half of
+ *        the inputs changed.
+ *
+ *        The parameters are read from the layers. Call reset() after they
+ *        change, e.g. after training.
+ */
+class IncrementalPredictor final : public Interface {
+public:
+  /**
+   * @brief Create a new predictor.
+   *
+   * @param[in] hiddenLayer The hidden layer in the neural network.
+   * @param[in] outputLayer The output layer in the neural network.
+   * @param[in] refreshInterval The number of predictions between full
+   *                            recomputations (default = 64).
+   */
+  explicit IncrementalPredictor(const ml::dense_layer::Interface &hiddenLayer,
+                                const ml::dense_layer::Interface &outputLayer,
+                                const size_t refreshInterval = 64U);
+
+  /**
+   * @brief Delete the predictor.
+   */
+  ~IncrementalPredictor() noexcept override = default;
+
+  /**
+   * @brief Predict the output for the given input.
+   *
+   * @param[in] input Input values, must hold one value per hidden weight.
+   *
+   * @return The output values, empty if the input doesn't match.
+   */
+  const ml::Matrix1d &predict(const ml::Matrix1d &input) noexcept override;
+
+  /**
+   * @brief Drop the kept sums, the next prediction recomputes everything.
+   */
+  void reset() noexcept;
+
+  IncrementalPredictor() = delete;                             // No default.
+  IncrementalPredictor(const IncrementalPredictor &) = delete; // No copy.
+  IncrementalPredictor(IncrementalPredictor &&) = delete;      // No move.
+  IncrementalPredictor &
+  operator=(const IncrementalPredictor &) = delete; // No copy.
+  IncrementalPredictor &operator=(IncrementalPredictor &&) = delete; // No move.
+
+private:
+  void recompute(const ml::Matrix1d &input) noexcept;
+
+  /** Reference to the hidden layer. */
+  const ml::dense_layer::Interface &myHiddenLayer;
+
+  /** Reference to the output layer. */
+  const ml::dense_layer::Interface &myOutputLayer;
+
+  /** The number of predictions between full recomputations. */
+  const size_t myRefreshInterval;
+
+  /** The input of the last prediction. */
+  ml::Matrix1d myInput;
+
+  /** Weighted sums of the hidden layer for the last input. */
+  ml::Matrix1d mySums;
+
+  /** Hidden layer outputs. */
+  ml::Matrix1d myHiddenOutput;
+
+  /** Output layer outputs. */
+  ml::Matrix1d myOutput;
+
+  /** The number of incremental updates since the last recomputation. */
+  size_t myUpdateCount;
+
+  /** Indicates whether the sums match the kept input. */
+  bool myValid;
+};
+} // namespace ml::neural_network
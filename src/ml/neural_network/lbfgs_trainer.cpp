@@ -0,0 +1,349 @@
+/**
+ * @brief Full-batch L-BFGS trainer implementation details.
+ */
+#include <zephyr/sys/printk.h>
+
+#include "ml/dense_layer/kernels.hpp"
+#include "ml/neural_network/lbfgs_trainer.hpp"
+
+namespace ml::neural_network {
+namespace {
+/** The maximum number of step halvings per line search. */
+constexpr size_t MaxLineSearchSteps{20U};
+
+/** Required fraction of the predicted decrease for a step to be accepted. */
+constexpr double SufficientDecrease{1e-4};
+
+// -----------------------------------------------------------------------------
+constexpr size_t min(const size_t x, const size_t y) noexcept {
+  return x <= y ? x : y;
+}
+
+// -----------------------------------------------------------------------------
+size_t parameterCount(const ml::dense_layer::Interface &layer) noexcept {
+  return layer.nodeCount() * (layer.weightCount() + 1U);
+}
+
+// -----------------------------------------------------------------------------
+double dot(const ml::Matrix1d &x, const ml::Matrix1d &y) noexcept {
+  double sum{};
+  for (size_t i{}; i < x.size(); ++i) {
+    sum += x[i] * y[i];
+  }
+  return sum;
+}
+
+// -----------------------------------------------------------------------------
+void copyValues(const ml::Matrix1d &source, ml::Matrix1d &target) noexcept {
+  for (size_t i{}; i < source.size(); ++i) {
+    target[i] = source[i];
+  }
+}
+
+// -----------------------------------------------------------------------------
+size_t addGradient(const ml::Matrix1d &error, const ml::Matrix1d &input,
+                   const double scale, ml::Matrix1d &gradient,
+                   size_t offset) noexcept {
+  // Weights first, [node][weight] row by row, then the bias values.
+  for (size_t i{}; i < error.size(); ++i) {
+    for (size_t j{}; j < input.size(); ++j) {
+      gradient[offset++] += scale * error[i] * input[j];
+    }
+  }
+  for (size_t i{}; i < error.size(); ++i) {
+    gradient[offset++] += scale * error[i];
+  }
+  return offset;
+}
+
+// -----------------------------------------------------------------------------
+size_t unflatten(const ml::Matrix1d &parameters, size_t offset,
+                 ml::Matrix2d &weights, ml::Matrix1d &bias) noexcept {
+  for (auto &nodeWeights : weights) {
+    for (auto &weight : nodeWeights) {
+      weight = parameters[offset++];
+    }
+  }
+  for (auto &value : bias) {
+    value = parameters[offset++];
+  }
+  return offset;
+}
+
+// -----------------------------------------------------------------------------
+size_t flatten(const ml::dense_layer::Interface &layer, size_t offset,
+               ml::Matrix1d &parameters) noexcept {
+  for (const auto &nodeWeights : layer.weights()) {
+    for (const auto &weight : nodeWeights) {
+      parameters[offset++] = weight;
+    }
+  }
+  for (const auto &value : layer.bias()) {
+    parameters[offset++] = value;
+  }
+  return offset;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+LbfgsTrainer::LbfgsTrainer(ml::dense_layer::Interface &hiddenLayer,
+                           ml::dense_layer::Interface &outputLayer,
+                           const ml::Matrix2d &trainInput,
+                           const ml::Matrix2d &trainOutput,
+                           const size_t historySize)
+    : myHiddenLayer{hiddenLayer}, myOutputLayer{outputLayer},
+      myTrainInput{trainInput}, myTrainOutput{trainOutput},
+      myTrainSetCount{min(trainInput.size(), trainOutput.size())},
+      myHistorySize{historySize}, myS{}, myY{}, myRho{}, myAlpha{},
+      myParameters{}, myGradient{}, myTrial{}, myDirection{}, myStep{},
+      myGradientChange{}, myHiddenOutput{}, myHiddenError{}, myHiddenBias{},
+      myHiddenWeights{}, myOutputOutput{}, myOutputError{}, myOutputBias{},
+      myOutputWeights{}, myPairCount{}, myNewest{}, myIterationsUsed{0} {
+  // Make sure the history size is valid and the layers connect properly.
+  if ((0U == historySize) || (MaxHistorySize < historySize) ||
+      (0U == myTrainSetCount) ||
+      (hiddenLayer.nodeCount() != outputLayer.weightCount()) ||
+      (ml::ActFunc::Softmax == hiddenLayer.actFunc())) {
+    printk("invalid L-BFGS trainer parameters\n");
+    while (1) {
+    }
+  }
+  if (!init()) {
+    printk("failed to allocate L-BFGS trainer buffers\n");
+    while (1) {
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+bool LbfgsTrainer::train(const size_t maxIterations) noexcept {
+  getParameters(myParameters);
+  auto currentLoss{lossAndGradient(myGradient)};
+  myPairCount = 0U;
+
+  while (!isPredictDone()) {
+    if (static_cast<size_t>(myIterationsUsed) >= maxIterations) {
+      return false;
+    }
+    ++myIterationsUsed;
+
+    // Fall back to steepest descent if the quasi-Newton direction isn't a
+    // descent direction, which can happen on non-convex losses.
+    direction();
+    auto slope{dot(myGradient, myDirection)};
+
+    if (0.0 <= slope) {
+      myPairCount = 0U;
+      direction();
+      slope = dot(myGradient, myDirection);
+    }
+    if (0.0 == slope) {
+      return false;
+    }
+
+    // Build the new correction pair in scratch buffers, the slot it goes to
+    // may still hold the oldest live pair until the new one is accepted.
+    auto &s{myStep};
+    auto &y{myGradientChange};
+    copyValues(myGradient, y);
+
+    // Backtracking line search until the loss decreases sufficiently.
+    auto step{1.0};
+    auto accepted{false};
+
+    for (size_t k{}; (k < MaxLineSearchSteps) && !accepted; ++k) {
+      for (size_t p{}; p < myParameters.size(); ++p) {
+        s[p] = step * myDirection[p];
+        myTrial[p] = myParameters[p] + s[p];
+      }
+      if (!setParameters(myTrial)) {
+        return false;
+      }
+      const auto trialLoss{loss()};
+
+      if (trialLoss <= currentLoss + SufficientDecrease * step * slope) {
+        currentLoss = trialLoss;
+        accepted = true;
+      } else {
+        step *= 0.5;
+      }
+    }
+
+    if (!accepted) {
+      // Restore the last accepted parameters; give up if even steepest
+      // descent made no progress.
+      if (!setParameters(myParameters) || (0U == myPairCount)) {
+        return false;
+      }
+      myPairCount = 0U;
+      continue;
+    }
+    copyValues(myTrial, myParameters);
+    currentLoss = lossAndGradient(myGradient);
+
+    // Store the correction pair, skipping it if it would break positive
+    // definiteness of the inverse Hessian approximation.
+    for (size_t p{}; p < myGradient.size(); ++p) {
+      y[p] = myGradient[p] - y[p];
+    }
+    const auto sy{dot(s, y)};
+
+    if (1e-12 < sy) {
+      const auto next{0U == myPairCount ? 0U
+                                        : (myNewest + 1U) % myHistorySize};
+      copyValues(s, myS[next]);
+      copyValues(y, myY[next]);
+      myRho[next] = 1.0 / sy;
+      myNewest = next;
+      myPairCount = min(myPairCount + 1U, myHistorySize);
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool LbfgsTrainer::isPredictDone() noexcept {
+  using namespace ml::dense_layer;
+
+  for (size_t k{}; k < myTrainSetCount; ++k) {
+    forward(myHiddenLayer, myTrainInput[k], myHiddenOutput);
+    forward(myOutputLayer, myHiddenOutput, myOutputOutput);
+
+    if (!isCorrect(myOutputLayer, myOutputOutput, myTrainOutput[k])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+int LbfgsTrainer::getIterationsUsed() const noexcept {
+  return myIterationsUsed;
+}
+
+// -----------------------------------------------------------------------------
+size_t LbfgsTrainer::stateBytes() const noexcept {
+  return requiredBytes(myParameters.size(), myHistorySize);
+}
+
+// -----------------------------------------------------------------------------
+bool LbfgsTrainer::init() noexcept {
+  using ml::dense_layer::resizeZero;
+  const auto count{parameterCount(myHiddenLayer) +
+                   parameterCount(myOutputLayer)};
+  const auto hiddenCount{myHiddenLayer.nodeCount()};
+  const auto outputCount{myOutputLayer.nodeCount()};
+
+  return resizeZero(myS, myHistorySize, count) &&
+         resizeZero(myY, myHistorySize, count) &&
+         resizeZero(myRho, myHistorySize) &&
+         resizeZero(myAlpha, myHistorySize) &&
+         resizeZero(myParameters, count) && resizeZero(myGradient, count) &&
+         resizeZero(myTrial, count) && resizeZero(myDirection, count) &&
+         resizeZero(myStep, count) && resizeZero(myGradientChange, count) &&
+         resizeZero(myHiddenOutput, hiddenCount) &&
+         resizeZero(myHiddenError, hiddenCount) &&
+         resizeZero(myHiddenBias, hiddenCount) &&
+         resizeZero(myHiddenWeights, hiddenCount,
+                    myHiddenLayer.weightCount()) &&
+         resizeZero(myOutputOutput, outputCount) &&
+         resizeZero(myOutputError, outputCount) &&
+         resizeZero(myOutputBias, outputCount) &&
+         resizeZero(myOutputWeights, outputCount, hiddenCount);
+}
+
+// -----------------------------------------------------------------------------
+double LbfgsTrainer::lossAndGradient(ml::Matrix1d &gradient) noexcept {
+  using namespace ml::dense_layer;
+
+  // The layer errors point downhill, so the loss gradient is their negated
+  // mean.
+  const auto scale{-1.0 / static_cast<double>(myTrainSetCount)};
+  double sum{};
+  setZero(gradient);
+
+  for (size_t k{}; k < myTrainSetCount; ++k) {
+    forward(myHiddenLayer, myTrainInput[k], myHiddenOutput);
+    forward(myOutputLayer, myHiddenOutput, myOutputOutput);
+    outputError(myOutputLayer, myOutputOutput, myTrainOutput[k],
+                myOutputError);
+    hiddenError(myHiddenLayer, myHiddenOutput, myOutputLayer, myOutputError,
+                myHiddenError);
+
+    sum += sampleLoss(myOutputLayer, myOutputOutput, myTrainOutput[k]);
+    const auto offset{
+        addGradient(myHiddenError, myTrainInput[k], scale, gradient, 0U)};
+    addGradient(myOutputError, myHiddenOutput, scale, gradient, offset);
+  }
+  return sum / static_cast<double>(myTrainSetCount);
+}
+
+// -----------------------------------------------------------------------------
+double LbfgsTrainer::loss() noexcept {
+  using namespace ml::dense_layer;
+  double sum{};
+
+  for (size_t k{}; k < myTrainSetCount; ++k) {
+    forward(myHiddenLayer, myTrainInput[k], myHiddenOutput);
+    forward(myOutputLayer, myHiddenOutput, myOutputOutput);
+    sum += sampleLoss(myOutputLayer, myOutputOutput, myTrainOutput[k]);
+  }
+  return sum / static_cast<double>(myTrainSetCount);
+}
+
+// -----------------------------------------------------------------------------
+void LbfgsTrainer::direction() noexcept {
+  // Two-loop recursion: direction = -H * gradient, where H approximates the
+  // inverse Hessian from the stored correction pairs.
+  auto &q{myDirection};
+  copyValues(myGradient, q);
+
+  auto index{myNewest};
+  for (size_t k{}; k < myPairCount; ++k) {
+    myAlpha[index] = myRho[index] * dot(myS[index], q);
+
+    for (size_t p{}; p < q.size(); ++p) {
+      q[p] -= myAlpha[index] * myY[index][p];
+    }
+    index = (index + myHistorySize - 1U) % myHistorySize;
+  }
+
+  // Scale by the curvature of the newest pair as initial Hessian guess.
+  if (0U < myPairCount) {
+    const auto gamma{dot(myS[myNewest], myY[myNewest]) /
+                     dot(myY[myNewest], myY[myNewest])};
+    for (auto &value : q) {
+      value *= gamma;
+    }
+  }
+
+  index = (myNewest + myHistorySize + 1U - myPairCount) % myHistorySize;
+  for (size_t k{}; k < myPairCount; ++k) {
+    const auto beta{myRho[index] * dot(myY[index], q)};
+
+    for (size_t p{}; p < q.size(); ++p) {
+      q[p] += (myAlpha[index] - beta) * myS[index][p];
+    }
+    index = (index + 1U) % myHistorySize;
+  }
+
+  for (auto &value : q) {
+    value = -value;
+  }
+}
+
+// -----------------------------------------------------------------------------
+bool LbfgsTrainer::setParameters(const ml::Matrix1d &parameters) noexcept {
+  const auto offset{
+      unflatten(parameters, 0U, myHiddenWeights, myHiddenBias)};
+  unflatten(parameters, offset, myOutputWeights, myOutputBias);
+  return myHiddenLayer.setParameters(myHiddenWeights, myHiddenBias) &&
+         myOutputLayer.setParameters(myOutputWeights, myOutputBias);
+}
+
+// -----------------------------------------------------------------------------
+void LbfgsTrainer::getParameters(ml::Matrix1d &parameters) const noexcept {
+  const auto offset{flatten(myHiddenLayer, 0U, parameters)};
+  flatten(myOutputLayer, offset, parameters);
+}
+} // namespace ml::neural_network
@@ -0,0 +1,187 @@
+/**
+ * @brief Full-batch L-BFGS trainer for single layer neural networks.
+ */
+#pragma once
+
+#include "ml/dense_layer/interface.hpp"
+#include "ml/types.hpp"
+
+namespace ml::neural_network {
+/**
+ * @brief Full-batch L-BFGS trainer for single layer neural networks.
+ *
+ *        Each iteration computes the mean loss and its gradient over the
+ *        whole training set, builds a quasi-Newton search direction from
+ *        the last few parameter and gradient changes and takes a backtracking
+ *        line search step along it. This typically needs far fewer passes
+ *        over the data than gradient descent, but holds several copies of
+ *        all parameters, so it's intended for small problems.
+ *
+ *        The loss is the cross-entropy for a softmax output layer and half
+ *        the squared error otherwise, see ml::dense_layer::sampleLoss().
+ *        The hidden layer can't use softmax.
+ *
+ *        The trainer writes the parameters directly, optimizers attached to
+ *        the layers are not used.
+ */
+class LbfgsTrainer final {
+public:
+  /**
+   * @brief Create a new trainer.
+   *
+   * @param[in] hiddenLayer The hidden layer in the neural network.
+   * @param[in] outputLayer The output layer in the neural network.
+   * @param[in] trainInput The input data that the model should train.
+   * @param[in] trainOutput The output data that the model should be trained
+   *                        to predict.
+   * @param[in] historySize The number of correction pairs to keep, 1 -
+   *                        MaxHistorySize (default = 5).
+   */
+  explicit LbfgsTrainer(ml::dense_layer::Interface &hiddenLayer,
+                        ml::dense_layer::Interface &outputLayer,
+                        const ml::Matrix2d &trainInput,
+                        const ml::Matrix2d &trainOutput,
+                        const size_t historySize = 5U);
+
+  /**
+   * @brief Delete the trainer.
+   */
+  ~LbfgsTrainer() noexcept = default;
+
+  /** The maximum number of correction pairs. */
+  static constexpr size_t MaxHistorySize{16U};
+
+  /**
+   * @brief Get the state size for a network of given dimensions.
+   *
+   * @param[in] parameterCount The total number of weights and bias values.
+   * @param[in] historySize The number of correction pairs.
+   *
+   * @return The number of bytes of state values.
+   */
+  static constexpr size_t requiredBytes(const size_t parameterCount,
+                                        const size_t historySize) noexcept {
+    // Two vectors per correction pair, plus parameters, gradient, trial
+    // parameters, direction and the pair under test, plus two scalars per
+    // pair.
+    return ((2U * historySize + 6U) * parameterCount + 2U * historySize) *
+           sizeof(double);
+  }
+
+  /**
+   * @brief Train the model until all predictions are correct.
+   *
+   * @param[in] maxIterations The maximum number of iterations to run.
+   *
+   * @return True if training is done, or false on error or if the
+   *         iteration limit was reached.
+   */
+  bool train(const size_t maxIterations = 1000U) noexcept;
+
+  /**
+   * @brief Check if the prediction is correct for the whole training set.
+   *
+   *        See ml::dense_layer::isCorrect() for what counts as correct.
+   *
+   * @return True if prediction is done, or false if not.
+   */
+  bool isPredictDone() noexcept;
+
+  /**
+   * @brief Get the amount of iterations used during training.
+   *
+   *        Each iteration is one full-batch gradient evaluation plus its line
+   *        search.
+   *
+   * @return The number of iterations used.
+   */
+  int getIterationsUsed() const noexcept;
+
+  /**
+   * @brief Get the size of the trainer state.
+   *
+   * @return The number of bytes of state values currently allocated.
+   */
+  size_t stateBytes() const noexcept;
+
+  LbfgsTrainer() = delete;                                // No default.
+  LbfgsTrainer(const LbfgsTrainer &) = delete;            // No copy.
+  LbfgsTrainer(LbfgsTrainer &&) = delete;                 // No move.
+  LbfgsTrainer &operator=(const LbfgsTrainer &) = delete; // No copy.
+  LbfgsTrainer &operator=(LbfgsTrainer &&) = delete;      // No move.
+
+private:
+  bool init() noexcept;
+  double lossAndGradient(ml::Matrix1d &gradient) noexcept;
+  double loss() noexcept;
+  void direction() noexcept;
+  bool setParameters(const ml::Matrix1d &parameters) noexcept;
+  void getParameters(ml::Matrix1d &parameters) const noexcept;
+
+  /** Reference to the hidden layer. */
+  ml::dense_layer::Interface &myHiddenLayer;
+
+  /** Reference to the output layer. */
+  ml::dense_layer::Interface &myOutputLayer;
+
+  /** Reference to the training input. */
+  const ml::Matrix2d &myTrainInput;
+
+  /** Reference to the training output. */
+  const ml::Matrix2d &myTrainOutput;
+
+  /** The number of available training samples. */
+  const size_t myTrainSetCount;
+
+  /** The number of correction pairs to keep. */
+  const size_t myHistorySize;
+
+  /** Parameter changes of the last iterations, [pair][parameter]. */
+  ml::Matrix2d myS;
+
+  /** Gradient changes of the last iterations, [pair][parameter]. */
+  ml::Matrix2d myY;
+
+  /** 1 / (y^T * s) of each correction pair. */
+  ml::Matrix1d myRho;
+
+  /** Scratch coefficients of the two-loop recursion. */
+  ml::Matrix1d myAlpha;
+
+  /** Flattened parameters: hidden weights, hidden bias, output weights,
+   * output bias. */
+  ml::Matrix1d myParameters;
+
+  /** Flattened loss gradient at the current parameters. */
+  ml::Matrix1d myGradient;
+
+  /** Flattened parameters tried by the line search. */
+  ml::Matrix1d myTrial;
+
+  /** Flattened search direction. */
+  ml::Matrix1d myDirection;
+
+  /** Parameter change of the current iteration, before it is stored. */
+  ml::Matrix1d myStep;
+
+  /** Gradient change of the current iteration, before it is stored. */
+  ml::Matrix1d myGradientChange;
+
+  /** Hidden layer outputs, errors and parameter buffers. */
+  ml::Matrix1d myHiddenOutput, myHiddenError, myHiddenBias;
+  ml::Matrix2d myHiddenWeights;
+
+  /** Output layer outputs, errors and parameter buffers. */
+  ml::Matrix1d myOutputOutput, myOutputError, myOutputBias;
+  ml::Matrix2d myOutputWeights;
+
+  /** The number of correction pairs stored. */
+  size_t myPairCount;
+
+  /** Index of the newest correction pair. */
+  size_t myNewest;
+
+  /** The amount of iterations used. */
+  int myIterationsUsed;
+};
+} // namespace ml::neural_network
@@ -0,0 +1,245 @@
+/**
+ * @brief Neural network compiled into a lookup table implementation details.
+ */
+#include <math.h>
+
+#include <zephyr/sys/printk.h>
+
+#include "ml/dense_layer/kernels.hpp"
+#include "ml/neural_network/lookup_table.hpp"
+
+namespace ml::neural_network {
+namespace {
+/** Relative tolerance when checking that values are evenly spaced. */
+constexpr double SpacingTolerance{1e-9};
+} // namespace
+
+// -----------------------------------------------------------------------------
+LookupTable::LookupTable(const size_t maxEntryCount) noexcept
+    : myMaxEntryCount{maxEntryCount}, myFeatures{}, myFeatureCount{},
+      myEntryCount{}, myOutputCount{}, myTable{}, myOutput{} {}
+
+// -----------------------------------------------------------------------------
+bool LookupTable::setDomain(const Feature *features,
+                            const size_t featureCount) noexcept {
+  myFeatureCount = 0U;
+  myEntryCount = 0U;
+  myOutputCount = 0U;
+
+  if ((nullptr == features) || (0U == featureCount) ||
+      (MaxFeatureCount < featureCount)) {
+    return false;
+  }
+  size_t entryCount{1U};
+
+  for (size_t f{}; f < featureCount; ++f) {
+    const auto &feature{features[f]};
+
+    // Stop before the product can overflow.
+    if ((0U == feature.levelCount) || (feature.min > feature.max) ||
+        (myMaxEntryCount / feature.levelCount < entryCount)) {
+      printk("input domain too large for lookup table\n");
+      return false;
+    }
+    entryCount *= feature.levelCount;
+    myFeatures[f] = feature;
+  }
+  myFeatureCount = featureCount;
+  myEntryCount = entryCount;
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool LookupTable::setBinaryDomain(const size_t featureCount) noexcept {
+  Feature features[MaxFeatureCount]{};
+
+  for (auto &feature : features) {
+    feature = {0.0, 1.0, 2U};
+  }
+  return setDomain(features, featureCount);
+}
+
+// -----------------------------------------------------------------------------
+bool LookupTable::detectDomain(const ml::Matrix2d &inputs,
+                               const size_t maxLevelCount) noexcept {
+  if (inputs.empty() || (0U == maxLevelCount)) {
+    return false;
+  }
+  const auto featureCount{inputs[0U].size()};
+  Feature features[MaxFeatureCount]{};
+
+  if (MaxFeatureCount < featureCount) {
+    return false;
+  }
+  ml::Matrix1d levels(maxLevelCount);
+
+  for (size_t f{}; f < featureCount; ++f) {
+    size_t levelCount{};
+
+    // Collect the distinct values in ascending order.
+    for (const auto &input : inputs) {
+      if (input.size() != featureCount) {
+        return false;
+      }
+      const auto x{input[f]};
+      size_t k{};
+
+      while ((k < levelCount) && (levels[k] < x)) {
+        ++k;
+      }
+      if ((k < levelCount) && (levels[k] == x)) {
+        continue;
+      }
+      if (maxLevelCount == levelCount) {
+        return false;
+      }
+      for (auto m{levelCount}; m > k; --m) {
+        levels[m] = levels[m - 1U];
+      }
+      levels[k] = x;
+      ++levelCount;
+    }
+
+    // The values must form an evenly spaced grid.
+    const auto min{levels[0U]};
+    const auto max{levels[levelCount - 1U]};
+    const auto step{1U < levelCount ? (max - min) / (levelCount - 1U) : 0.0};
+
+    for (size_t k{}; k < levelCount; ++k) {
+      if (fabs(levels[k] - (min + k * step)) >
+          SpacingTolerance * (1.0 + fabs(max - min))) {
+        return false;
+      }
+    }
+    features[f] = {min, max, levelCount};
+  }
+  return setDomain(features, featureCount);
+}
+
+// -----------------------------------------------------------------------------
+bool LookupTable::compile(Interface &network) noexcept {
+  if (0U == myEntryCount) {
+    return false;
+  }
+  ml::Matrix1d input(myFeatureCount);
+
+  for (size_t e{}; e < myEntryCount; ++e) {
+    entryInput(e, input);
+    const auto &output{network.predict(input)};
+
+    // Size the table once the number of outputs is known.
+    if ((0U == e) &&
+        (output.empty() ||
+         !ml::dense_layer::resizeZero(myTable, myEntryCount * output.size()) ||
+         !ml::dense_layer::resizeZero(myOutput, output.size()))) {
+      printk("failed to allocate lookup table\n");
+      return false;
+    }
+    myOutputCount = output.size();
+
+    for (size_t i{}; i < myOutputCount; ++i) {
+      myTable[e * myOutputCount + i] = output[i];
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool LookupTable::verify(Interface &network, const ml::Matrix2d &inputs,
+                         const double tolerance) noexcept {
+  if (0U == myOutputCount) {
+    return false;
+  }
+  ml::Matrix1d input(myFeatureCount);
+
+  for (size_t e{}; e < myEntryCount; ++e) {
+    entryInput(e, input);
+    const auto &output{network.predict(input)};
+
+    for (size_t i{}; i < myOutputCount; ++i) {
+      if (fabs(output[i] - entry(e)[i]) > tolerance) {
+        printk("lookup table entry %u differs\n", (unsigned)e);
+        return false;
+      }
+    }
+  }
+  for (size_t s{}; s < inputs.size(); ++s) {
+    if (inputs[s].size() != myFeatureCount) {
+      return false;
+    }
+    const auto &output{network.predict(inputs[s])};
+    const auto values{entry(index(inputs[s].data()))};
+
+    for (size_t i{}; i < myOutputCount; ++i) {
+      if (fabs(output[i] - values[i]) > tolerance) {
+        printk("input %u is outside the lookup table domain\n", (unsigned)s);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+size_t LookupTable::index(const double *input) const noexcept {
+  size_t index{};
+
+  for (size_t f{}; f < myFeatureCount; ++f) {
+    const auto &feature{myFeatures[f]};
+    size_t level{};
+
+    // Round to the nearest level, clamped to the domain.
+    if ((1U < feature.levelCount) && (input[f] > feature.min)) {
+      const auto step{(feature.max - feature.min) / (feature.levelCount - 1U)};
+      level = static_cast<size_t>((input[f] - feature.min) / step + 0.5);
+
+      if (level >= feature.levelCount) {
+        level = feature.levelCount - 1U;
+      }
+    }
+    index = index * feature.levelCount + level;
+  }
+  return index;
+}
+
+// -----------------------------------------------------------------------------
+const ml::Matrix1d &LookupTable::predict(const ml::Matrix1d &input) noexcept {
+  if ((0U == myOutputCount) || (input.size() != myFeatureCount)) {
+    static const ml::Matrix1d empty{};
+    return empty;
+  }
+  const auto values{entry(index(input.data()))};
+
+  for (size_t i{}; i < myOutputCount; ++i) {
+    myOutput[i] = values[i];
+  }
+  return myOutput;
+}
+
+// -----------------------------------------------------------------------------
+size_t LookupTable::entryCount() const noexcept { return myEntryCount; }
+
+// -----------------------------------------------------------------------------
+size_t LookupTable::outputCount() const noexcept { return myOutputCount; }
+
+// -----------------------------------------------------------------------------
+double LookupTable::value(const size_t feature,
+                          const size_t level) const noexcept {
+  const auto &range{myFeatures[feature]};
+
+  if (1U >= range.levelCount) {
+    return range.min;
+  }
+  return range.min + (range.max - range.min) * level / (range.levelCount - 1U);
+}
+
+// -----------------------------------------------------------------------------
+void LookupTable::entryInput(size_t index, ml::Matrix1d &input) const noexcept {
+  // Peel off the levels from the least significant feature upwards.
+  for (auto f{myFeatureCount}; f > 0U; --f) {
+    const auto levelCount{myFeatures[f - 1U].levelCount};
+    input[f - 1U] = value(f - 1U, index % levelCount);
+    index /= levelCount;
+  }
+}
+} // namespace ml::neural_network
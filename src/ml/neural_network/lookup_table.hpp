@@ -0,0 +1,183 @@
+/**
+ * @brief Neural network compiled into a lookup table.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/neural_network/interface.hpp"
+#include "ml/types.hpp"
+
+namespace ml::neural_network {
+/**
+ * @brief Neural network compiled into a lookup table.
+ *
+ *        If every input feature only takes a few evenly spaced values, e.g.
+ *        button bits or coarsely quantized sensor readings, the network can
+ *        be evaluated once for every possible input up front. Prediction is
+ *        then a single indexed load.
+ *
+ *        Feature 0 is the most significant digit of the table index, so for
+ *        binary features the index equals the input bits read as a number.
+ */
+class LookupTable final : public Interface {
+public:
+  /** The maximum number of input features. */
+  static constexpr size_t MaxFeatureCount{16U};
+
+  /** Value range of one input feature. */
+  struct Feature {
+    double min;        ///< The lowest value of the feature.
+    double max;        ///< The highest value of the feature.
+    size_t levelCount; ///< The number of evenly spaced values, min to max.
+  };
+
+  /**
+   * @brief Create a new empty table.
+   *
+   * @param[in] maxEntryCount The largest number of table entries to accept
+   *                          (default = 4096).
+   */
+  explicit LookupTable(const size_t maxEntryCount = 4096U) noexcept;
+
+  /**
+   * @brief Delete the table.
+   */
+  ~LookupTable() noexcept override = default;
+
+  /**
+   * @brief Use the given input domain.
+   *
+   * @param[in] features The value range of each feature.
+   * @param[in] featureCount The number of features, 1 - MaxFeatureCount.
+   *
+   * @return True if the domain fits in the table, or false if not.
+   */
+  bool setDomain(const Feature *features, const size_t featureCount) noexcept;
+
+  /**
+   * @brief Use a domain of binary features, each either 0 or 1.
+   *
+   * @param[in] featureCount The number of features, 1 - MaxFeatureCount.
+   *
+   * @return True if the domain fits in the table, or false if not.
+   */
+  bool setBinaryDomain(const size_t featureCount) noexcept;
+
+  /**
+   * @brief Detect the input domain from the given inputs.
+   *
+   *        Each feature has to take at most maxLevelCount distinct, evenly
+   *        spaced values over all inputs.
+   *
+   * @param[in] inputs The inputs to detect the domain from, [sample][feature].
+   * @param[in] maxLevelCount The largest number of values per feature
+   *                          (default = 16).
+   *
+   * @return True if a domain that fits in the table was found, or false if
+   *         not.
+   */
+  bool detectDomain(const ml::Matrix2d &inputs,
+                    const size_t maxLevelCount = 16U) noexcept;
+
+  /**
+   * @brief Evaluate the network for every input in the domain.
+   *
+   * @param[in] network The network to compile.
+   *
+   * @return True if the table was filled, or false on error.
+   */
+  bool compile(Interface &network) noexcept;
+
+  /**
+   * @brief Check the table against the network.
+   *
+   *        Every entry is compared with a fresh prediction, and every given
+   *        input must map to an entry that matches the network's prediction
+   *        for that exact input, i.e. it must lie on the domain grid.
+   *
+   * @param[in] network The network the table was compiled from.
+   * @param[in] inputs Real inputs to check, [sample][feature].
+   * @param[in] tolerance The largest accepted difference (default = 1e-9).
+   *
+   * @return True if the table matches the network, or false if not.
+   */
+  bool verify(Interface &network, const ml::Matrix2d &inputs,
+              const double tolerance = 1e-9) noexcept;
+
+  /**
+   * @brief Get the table index of the given input.
+   *
+   *        Each feature is rounded to its nearest value in the domain.
+   *
+   * @param[in] input Input values, must hold one value per feature.
+   *
+   * @return The table index.
+   */
+  size_t index(const double *input) const noexcept;
+
+  /**
+   * @brief Get the outputs stored for the given table index.
+   *
+   * @param[in] index The table index, below entryCount().
+   *
+   * @return Pointer to outputCount() output values.
+   */
+  const double *entry(const size_t index) const noexcept {
+    return &myTable[index * myOutputCount];
+  }
+
+  /**
+   * @brief Predict the output for the given input from the table.
+   *
+   * @param[in] input Input values, must hold one value per feature.
+   *
+   * @return The output values, empty if the table isn't compiled.
+   */
+  const ml::Matrix1d &predict(const ml::Matrix1d &input) noexcept override;
+
+  /**
+   * @brief Get the number of table entries.
+   *
+   * @return The number of entries, one per possible input.
+   */
+  size_t entryCount() const noexcept;
+
+  /**
+   * @brief Get the number of outputs per entry.
+   *
+   * @return The number of outputs, 0 if the table isn't compiled.
+   */
+  size_t outputCount() const noexcept;
+
+  LookupTable(const LookupTable &) = delete;            // No copy constructor.
+  LookupTable(LookupTable &&) = delete;                 // No move constructor.
+  LookupTable &operator=(const LookupTable &) = delete; // No copy assignment.
+  LookupTable &operator=(LookupTable &&) = delete;      // No move assignment.
+
+private:
+  double value(const size_t feature, const size_t level) const noexcept;
+  void entryInput(size_t index, ml::Matrix1d &input) const noexcept;
+
+  /** The largest number of table entries to accept. */
+  const size_t myMaxEntryCount;
+
+  /** The value range of each feature. */
+  Feature myFeatures[MaxFeatureCount];
+
+  /** The number of features. */
+  size_t myFeatureCount;
+
+  /** The number of table entries. */
+  size_t myEntryCount;
+
+  /** The number of outputs per entry. */
+  size_t myOutputCount;
+
+  /** Outputs of every entry, [entry * outputCount + output]. */
+  ml::Matrix1d myTable;
+
+  /** Output of the last prediction. */
+  ml::Matrix1d myOutput;
+};
+} // namespace ml::neural_network
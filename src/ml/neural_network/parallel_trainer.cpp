@@ -0,0 +1,289 @@
+/**
+ * @brief Data-parallel trainer implementation details.
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/printk.h>
+
+#include "ml/dense_layer/kernels.hpp"
+#include "ml/neural_network/parallel_trainer.hpp"
+
+namespace ml::neural_network {
+namespace {
+/** Stack size of each worker thread in bytes. */
+constexpr size_t WorkerStackSize{2048U};
+
+/** Stacks of the worker threads, worker 0 uses the calling thread. */
+K_THREAD_STACK_ARRAY_DEFINE(workerStacks, ParallelTrainer::MaxWorkerCount - 1U,
+                            WorkerStackSize);
+
+/** Set while the worker stacks are owned by a trainer. */
+atomic_t stacksInUse = ATOMIC_INIT(0);
+
+// -----------------------------------------------------------------------------
+constexpr size_t min(const size_t x, const size_t y) noexcept {
+  return x <= y ? x : y;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+ParallelTrainer::ParallelTrainer(ml::dense_layer::Interface &hiddenLayer,
+                                 ml::dense_layer::Interface &outputLayer,
+                                 const ml::Matrix2d &trainInput,
+                                 const ml::Matrix2d &trainOutput,
+                                 const size_t workerCount)
+    : myHiddenLayer{hiddenLayer}, myOutputLayer{outputLayer},
+      myTrainInput{trainInput}, myTrainOutput{trainOutput},
+      myTrainSetCount{min(trainInput.size(), trainOutput.size())},
+      myWorkerCount{workerCount}, myWorkers{}, myDone{}, myJob{Job::Stop},
+      myEpochsUsed{0} {
+  // Make sure the worker count is valid and the layers connect properly, then
+  // claim the worker stacks. The claim is atomic, so trainers created on
+  // different threads can't both get them.
+  if ((0U == workerCount) || (MaxWorkerCount < workerCount) ||
+      (hiddenLayer.nodeCount() != outputLayer.weightCount()) ||
+      (ml::ActFunc::Softmax == hiddenLayer.actFunc()) ||
+      !atomic_cas(&stacksInUse, 0, 1)) {
+    printk("invalid parallel trainer parameters\n");
+    while (1) {
+    }
+  }
+  k_sem_init(&myDone, 0U, MaxWorkerCount);
+
+  const auto priority{k_thread_priority_get(k_current_get())};
+
+  for (size_t w{}; w < myWorkerCount; ++w) {
+    auto &worker{myWorkers[w]};
+
+    if (!initWorker(worker)) {
+      printk("failed to allocate parallel trainer buffers\n");
+      while (1) {
+      }
+    }
+    if (0U == w) {
+      continue;
+    }
+    // Create the thread suspended so it can be pinned before it starts.
+    k_sem_init(&worker.start, 0U, 1U);
+    const auto thread{k_thread_create(
+        &worker.thread, workerStacks[w - 1U],
+        K_THREAD_STACK_SIZEOF(workerStacks[w - 1U]), workerEntry, this,
+        reinterpret_cast<void *>(w), nullptr, priority, 0U, K_FOREVER)};
+#if defined(CONFIG_SCHED_CPU_MASK) && defined(CONFIG_MP_MAX_NUM_CPUS)
+    k_thread_cpu_pin(thread, static_cast<int>(w % CONFIG_MP_MAX_NUM_CPUS));
+#endif
+    k_thread_start(thread);
+  }
+}
+
+// -----------------------------------------------------------------------------
+ParallelTrainer::~ParallelTrainer() noexcept {
+  // Wake every worker thread with the stop job and wait for it to finish.
+  myJob = Job::Stop;
+
+  for (size_t w{1U}; w < myWorkerCount; ++w) {
+    k_sem_give(&myWorkers[w].start);
+    k_thread_join(&myWorkers[w].thread, K_FOREVER);
+  }
+  atomic_clear(&stacksInUse);
+}
+
+// -----------------------------------------------------------------------------
+bool ParallelTrainer::train(const double learningRate,
+                            const size_t batchSize) noexcept {
+  if ((0.0 >= learningRate) || (0U == batchSize)) {
+    return false;
+  }
+
+  while (!isPredictDone()) {
+    for (size_t begin{}; begin < myTrainSetCount; begin += batchSize) {
+      const auto end{min(begin + batchSize, myTrainSetCount)};
+
+      // Every worker accumulates the gradients of its shard of the batch.
+      run(Job::Gradient, begin, end);
+
+      if (!reduceAndUpdate(end - begin, learningRate)) {
+        return false;
+      }
+    }
+    ++myEpochsUsed;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool ParallelTrainer::isPredictDone() noexcept {
+  run(Job::Evaluate, 0U, myTrainSetCount);
+
+  for (size_t w{}; w < myWorkerCount; ++w) {
+    if (!myWorkers[w].result) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+int ParallelTrainer::getEpochsUsed() const noexcept { return myEpochsUsed; }
+
+// -----------------------------------------------------------------------------
+size_t ParallelTrainer::workerCount() const noexcept { return myWorkerCount; }
+
+// -----------------------------------------------------------------------------
+void ParallelTrainer::workerEntry(void *trainer, void *index, void *) noexcept {
+  auto &self{*static_cast<ParallelTrainer *>(trainer)};
+  auto &worker{self.myWorkers[reinterpret_cast<size_t>(index)]};
+
+  while (1) {
+    k_sem_take(&worker.start, K_FOREVER);
+
+    if (Job::Stop == self.myJob) {
+      return;
+    }
+    self.runJob(worker);
+    k_sem_give(&self.myDone);
+  }
+}
+
+// -----------------------------------------------------------------------------
+bool ParallelTrainer::initWorker(Worker &worker) noexcept {
+  using ml::dense_layer::resizeZero;
+  const auto hiddenCount{myHiddenLayer.nodeCount()};
+  const auto outputCount{myOutputLayer.nodeCount()};
+
+  return resizeZero(worker.hiddenOutput, hiddenCount) &&
+         resizeZero(worker.hiddenError, hiddenCount) &&
+         resizeZero(worker.outputOutput, outputCount) &&
+         resizeZero(worker.outputError, outputCount) &&
+         resizeZero(worker.hiddenWeightGradient, hiddenCount,
+                    myHiddenLayer.weightCount()) &&
+         resizeZero(worker.hiddenBiasGradient, hiddenCount) &&
+         resizeZero(worker.outputWeightGradient, outputCount, hiddenCount) &&
+         resizeZero(worker.outputBiasGradient, outputCount);
+}
+
+// -----------------------------------------------------------------------------
+void ParallelTrainer::run(const Job job, const size_t begin,
+                          const size_t end) noexcept {
+  // Split [begin, end) into contiguous shards, the first shards get one
+  // extra sample each if the samples don't divide evenly.
+  const auto count{end - begin};
+  const auto shardSize{count / myWorkerCount};
+  const auto remainder{count % myWorkerCount};
+  auto shardBegin{begin};
+
+  for (size_t w{}; w < myWorkerCount; ++w) {
+    auto &worker{myWorkers[w]};
+    worker.begin = shardBegin;
+    worker.end = shardBegin + shardSize + (w < remainder ? 1U : 0U);
+    shardBegin = worker.end;
+  }
+  myJob = job;
+
+  // Start the worker threads, do the first shard here, then wait for the
+  // others.
+  for (size_t w{1U}; w < myWorkerCount; ++w) {
+    k_sem_give(&myWorkers[w].start);
+  }
+  runJob(myWorkers[0U]);
+
+  for (size_t w{1U}; w < myWorkerCount; ++w) {
+    k_sem_take(&myDone, K_FOREVER);
+  }
+}
+
+// -----------------------------------------------------------------------------
+void ParallelTrainer::runJob(Worker &worker) noexcept {
+  switch (myJob) {
+  case Job::Gradient:
+    worker.result = computeGradient(worker);
+    break;
+  case Job::Evaluate:
+    worker.result = evaluate(worker);
+    break;
+  default:
+    worker.result = false;
+    break;
+  }
+}
+
+// -----------------------------------------------------------------------------
+bool ParallelTrainer::computeGradient(Worker &worker) noexcept {
+  using namespace ml::dense_layer;
+
+  setZero(worker.hiddenWeightGradient);
+  setZero(worker.hiddenBiasGradient);
+  setZero(worker.outputWeightGradient);
+  setZero(worker.outputBiasGradient);
+
+  for (size_t k{worker.begin}; k < worker.end; ++k) {
+    // (a) forward: hidden then output, into the worker's own buffers.
+    forward(myHiddenLayer, myTrainInput[k], worker.hiddenOutput);
+    forward(myOutputLayer, worker.hiddenOutput, worker.outputOutput);
+
+    // (b) backprop: output with target, then hidden with next layer.
+    outputError(myOutputLayer, worker.outputOutput, myTrainOutput[k],
+                worker.outputError);
+    if (!hiddenError(myHiddenLayer, worker.hiddenOutput, myOutputLayer,
+                     worker.outputError, worker.hiddenError)) {
+      return false;
+    }
+
+    // (c) accumulate: each layer with its own input source.
+    accumulateGradient(worker.hiddenError, myTrainInput[k],
+                       worker.hiddenWeightGradient, worker.hiddenBiasGradient);
+    accumulateGradient(worker.outputError, worker.hiddenOutput,
+                       worker.outputWeightGradient, worker.outputBiasGradient);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool ParallelTrainer::evaluate(Worker &worker) noexcept {
+  using namespace ml::dense_layer;
+
+  for (size_t k{worker.begin}; k < worker.end; ++k) {
+    forward(myHiddenLayer, myTrainInput[k], worker.hiddenOutput);
+    forward(myOutputLayer, worker.hiddenOutput, worker.outputOutput);
+
+    if (!isCorrect(myOutputLayer, worker.outputOutput, myTrainOutput[k])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+bool ParallelTrainer::reduceAndUpdate(const size_t sampleCount,
+                                      const double learningRate) noexcept {
+  auto &sum{myWorkers[0U]};
+
+  // Sum the gradients into worker 0 in a fixed order, so the floating-point
+  // result doesn't depend on which worker finished first.
+  for (size_t w{1U}; w < myWorkerCount; ++w) {
+    const auto &worker{myWorkers[w]};
+
+    for (size_t i{}; i < sum.hiddenBiasGradient.size(); ++i) {
+      sum.hiddenBiasGradient[i] += worker.hiddenBiasGradient[i];
+
+      for (size_t j{}; j < sum.hiddenWeightGradient[i].size(); ++j) {
+        sum.hiddenWeightGradient[i][j] += worker.hiddenWeightGradient[i][j];
+      }
+    }
+    for (size_t i{}; i < sum.outputBiasGradient.size(); ++i) {
+      sum.outputBiasGradient[i] += worker.outputBiasGradient[i];
+
+      for (size_t j{}; j < sum.outputWeightGradient[i].size(); ++j) {
+        sum.outputWeightGradient[i][j] += worker.outputWeightGradient[i][j];
+      }
+    }
+  }
+
+  // Apply the mean gradient of the batch as one shared update.
+  const auto rate{learningRate / static_cast<double>(sampleCount)};
+  return myHiddenLayer.update(sum.hiddenWeightGradient, sum.hiddenBiasGradient,
+                              rate) &&
+         myOutputLayer.update(sum.outputWeightGradient, sum.outputBiasGradient,
+                              rate);
+}
+} // namespace ml::neural_network
@@ -0,0 +1,186 @@
+/**
+ * @brief Data-parallel trainer for single layer neural networks.
+ */
+#pragma once
+
+#include <zephyr/kernel.h>
+
+#include "ml/dense_layer/interface.hpp"
+#include "ml/types.hpp"
+
+namespace ml::neural_network {
+/**
+ * @brief Data-parallel trainer for single layer neural networks.
+ *
+ *        Experimental, nothing in the application uses it and it hasn't been
+ *        measured to train faster than SingleLayer on any board.
+ *
+ *        Each mini-batch is split into one contiguous shard per worker. The
+ *        workers compute the gradients of their shards into private buffers,
+ *        which are then summed in worker order and applied as one shared
+ *        update. The shard boundaries and the reduction order only depend on
+ *        the worker count, so runs with the same worker count are
+ *        reproducible.
+ *
+ *        Worker 0 runs on the calling thread, the other workers run on
+ *        dedicated threads that are spread over the available CPUs.
+ *
+ *        The workers only run in parallel on SMP builds. prj.conf doesn't
+ *        enable CONFIG_SMP, so defaultWorkerCount() is 1 on the shipped
+ *        configuration, and native_sim threads never run concurrently.
+ *        With more than one worker and no SMP, the shards run one after
+ *        another.
+ *
+ *        A softmax output layer is trained with the cross-entropy loss and
+ *        its predictions count as correct once the class matches. The hidden
+ *        layer can't use softmax.
+ *
+ *        Only one trainer may exist at a time, since the worker stacks are
+ *        statically allocated.
+ */
+class ParallelTrainer final {
+public:
+  /** The maximum number of workers, including the calling thread. */
+  static constexpr size_t MaxWorkerCount{4U};
+
+  /**
+   * @brief Create a new trainer.
+   *
+   * @param[in] hiddenLayer The hidden layer in the neural network.
+   * @param[in] outputLayer The output layer in the neural network.
+   * @param[in] trainInput The input data that the model should train.
+   * @param[in] trainOutput The output data that the model should be trained
+   *                        to predict.
+   * @param[in] workerCount The number of workers to use, 1 - MaxWorkerCount
+   *                        (default = one per CPU).
+   */
+  explicit ParallelTrainer(ml::dense_layer::Interface &hiddenLayer,
+                           ml::dense_layer::Interface &outputLayer,
+                           const ml::Matrix2d &trainInput,
+                           const ml::Matrix2d &trainOutput,
+                           const size_t workerCount = defaultWorkerCount());
+
+  /**
+   * @brief Delete the trainer, stopping all worker threads.
+   */
+  ~ParallelTrainer() noexcept;
+
+  /**
+   * @brief Train the model until all predictions are correct.
+   *
+   * @param[in] learningRate The learning rate to use. Must exceed 0.
+   * @param[in] batchSize The number of samples per update. Must exceed 0.
+   *
+   * @return True if training is done, or false on error.
+   */
+  bool train(const double learningRate, const size_t batchSize) noexcept;
+
+  /**
+   * @brief Check if the prediction is correct for the whole training set.
+   *
+   *        See ml::dense_layer::isCorrect() for what counts as correct. The
+   *        check is spread over the workers as well.
+   *
+   * @return True if prediction is done, or false if not.
+   */
+  bool isPredictDone() noexcept;
+
+  /**
+   * @brief Get the amount of epochs used during training.
+   *
+   * @return The number of epochs used.
+   */
+  int getEpochsUsed() const noexcept;
+
+  /**
+   * @brief Get the number of workers used by the trainer.
+   *
+   * @return The number of workers.
+   */
+  size_t workerCount() const noexcept;
+
+  /**
+   * @brief Get the default number of workers, one per CPU.
+   *
+   * @return The default number of workers.
+   */
+  static constexpr size_t defaultWorkerCount() noexcept {
+#ifdef CONFIG_MP_MAX_NUM_CPUS
+    return CONFIG_MP_MAX_NUM_CPUS < MaxWorkerCount ? CONFIG_MP_MAX_NUM_CPUS
+                                                   : MaxWorkerCount;
+#else
+    return 1U;
+#endif
+  }
+
+  ParallelTrainer() = delete;                                   // No default.
+  ParallelTrainer(const ParallelTrainer &) = delete;            // No copy.
+  ParallelTrainer(ParallelTrainer &&) = delete;                 // No move.
+  ParallelTrainer &operator=(const ParallelTrainer &) = delete; // No copy.
+  ParallelTrainer &operator=(ParallelTrainer &&) = delete;      // No move.
+
+private:
+  /** Jobs the workers can perform. */
+  enum class Job {
+    Gradient, ///< Accumulate the gradients of the shard.
+    Evaluate, ///< Check whether the predictions of the shard are correct.
+    Stop,     ///< Terminate the worker thread.
+  };
+
+  /** Private buffers of a single worker. */
+  struct Worker {
+    ml::Matrix1d hiddenOutput;         ///< Hidden layer outputs.
+    ml::Matrix1d hiddenError;          ///< Hidden layer errors.
+    ml::Matrix1d outputOutput;         ///< Output layer outputs.
+    ml::Matrix1d outputError;          ///< Output layer errors.
+    ml::Matrix2d hiddenWeightGradient; ///< Hidden layer weight gradients.
+    ml::Matrix1d hiddenBiasGradient;   ///< Hidden layer bias gradients.
+    ml::Matrix2d outputWeightGradient; ///< Output layer weight gradients.
+    ml::Matrix1d outputBiasGradient;   ///< Output layer bias gradients.
+    size_t begin;                      ///< First sample of the shard.
+    size_t end;                        ///< One past the last sample.
+    bool result;                       ///< Result of the last job.
+    k_sem start;                       ///< Signalled to start a job.
+    k_thread thread;                   ///< Worker thread (unused by 0).
+  };
+
+  static void workerEntry(void *trainer, void *index, void *) noexcept;
+  bool initWorker(Worker &worker) noexcept;
+  void run(const Job job, const size_t begin, const size_t end) noexcept;
+  void runJob(Worker &worker) noexcept;
+  bool computeGradient(Worker &worker) noexcept;
+  bool evaluate(Worker &worker) noexcept;
+  bool reduceAndUpdate(const size_t sampleCount,
+                       const double learningRate) noexcept;
+
+  /** Reference to the hidden layer. */
+  ml::dense_layer::Interface &myHiddenLayer;
+
+  /** Reference to the output layer. */
+  ml::dense_layer::Interface &myOutputLayer;
+
+  /** Reference to the training input. */
+  const ml::Matrix2d &myTrainInput;
+
+  /** Reference to the training output. */
+  const ml::Matrix2d &myTrainOutput;
+
+  /** The number of available training samples. */
+  const size_t myTrainSetCount;
+
+  /** The number of workers in use. */
+  const size_t myWorkerCount;
+
+  /** Workers, index 0 runs on the calling thread. */
+  Worker myWorkers[MaxWorkerCount];
+
+  /** Signalled by a worker thread once its job is done. */
+  k_sem myDone;
+
+  /** The job currently being performed. */
+  Job myJob;
+
+  /** The amount of epochs used. */
+  int myEpochsUsed;
+};
+} // namespace ml::neural_network
@@ -0,0 +1,147 @@
+/**
+ * @brief Pruner implementation details.
+ */
+#include <math.h>
+
+#include <zephyr/sys/printk.h>
+
+#include "ml/dense_layer/kernels.hpp"
+#include "ml/neural_network/pruner.hpp"
+
+namespace ml::neural_network {
+namespace {
+// -----------------------------------------------------------------------------
+void swap(double &x, double &y) noexcept {
+  const auto temp{x};
+  x = y;
+  y = temp;
+}
+
+// -----------------------------------------------------------------------------
+// Find the k-th smallest value, reordering the values (quickselect).
+double select(ml::Matrix1d &values, const size_t k) noexcept {
+  size_t left{};
+  size_t right{values.size()};
+
+  while (1U < right - left) {
+    // Three-way partition, so the many zeros of pruned weights don't
+    // degrade it to quadratic time.
+    const auto pivot{values[left + (right - left) / 2U]};
+    size_t less{left};
+    size_t greater{right};
+
+    for (size_t i{left}; i < greater;) {
+      if (values[i] < pivot) {
+        swap(values[less++], values[i++]);
+      } else if (values[i] > pivot) {
+        swap(values[i], values[--greater]);
+      } else {
+        ++i;
+      }
+    }
+    if (k < less) {
+      right = less;
+    } else if (k >= greater) {
+      left = greater;
+    } else {
+      return pivot;
+    }
+  }
+  return values[left];
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+Pruner::Pruner(ml::dense_layer::Interface &layer)
+    : myLayer{layer}, myMask{}, myWeights{}, myPrunedCount{} {}
+
+// -----------------------------------------------------------------------------
+bool Pruner::prune(const double sparsity) noexcept {
+  const auto nodeCount{myLayer.nodeCount()};
+  const auto weightCount{myLayer.weightCount()};
+  const auto count{nodeCount * weightCount};
+
+  if ((0.0 > sparsity) || (1.0 < sparsity) || (0U == count)) {
+    printk("invalid sparsity\n");
+    return false;
+  }
+  const auto pruneCount{static_cast<size_t>(sparsity * count)};
+
+  if (((myMask.size() != count) && !myMask.resize(count)) ||
+      ((myWeights.size() != nodeCount) &&
+       !ml::dense_layer::resizeZero(myWeights, nodeCount, weightCount))) {
+    printk("failed to allocate pruning mask\n");
+    return false;
+  }
+  const auto &weights{myLayer.weights()};
+
+  // Find the magnitude of the last weight to prune.
+  double threshold{-1.0};
+  if (0U < pruneCount) {
+    ml::Matrix1d magnitudes(count);
+    if (magnitudes.size() != count) {
+      printk("failed to allocate pruning buffer\n");
+      return false;
+    }
+    for (size_t i{}; i < nodeCount; ++i) {
+      for (size_t j{}; j < weightCount; ++j) {
+        magnitudes[i * weightCount + j] = fabs(weights[i][j]);
+      }
+    }
+    threshold = select(magnitudes, pruneCount - 1U);
+  }
+
+  // Prune everything below the threshold, then weights at the threshold
+  // until exactly the requested number is pruned.
+  size_t belowCount{};
+  for (size_t i{}; i < nodeCount; ++i) {
+    for (size_t j{}; j < weightCount; ++j) {
+      belowCount += fabs(weights[i][j]) < threshold ? 1U : 0U;
+    }
+  }
+  auto tieCount{pruneCount - belowCount};
+
+  for (size_t i{}; i < nodeCount; ++i) {
+    for (size_t j{}; j < weightCount; ++j) {
+      const auto magnitude{fabs(weights[i][j])};
+      bool keep{threshold < magnitude};
+
+      if (!keep && (threshold == magnitude)) {
+        if (0U < tieCount) {
+          --tieCount;
+        } else {
+          keep = true;
+        }
+      }
+      myMask.set(i * weightCount + j, keep);
+    }
+  }
+  myPrunedCount = pruneCount;
+  return apply();
+}
+
+// -----------------------------------------------------------------------------
+bool Pruner::apply() noexcept {
+  if (!isActive()) {
+    return true;
+  }
+  const auto &weights{myLayer.weights()};
+  const auto weightCount{myLayer.weightCount()};
+
+  for (size_t i{}; i < myWeights.size(); ++i) {
+    for (size_t j{}; j < weightCount; ++j) {
+      myWeights[i][j] = myMask.test(i * weightCount + j) ? weights[i][j] : 0.0;
+    }
+  }
+  return myLayer.setParameters(myWeights, myLayer.bias());
+}
+
+// -----------------------------------------------------------------------------
+bool Pruner::isActive() const noexcept { return 0U < myPrunedCount; }
+
+// -----------------------------------------------------------------------------
+double Pruner::sparsity() const noexcept {
+  const auto count{myLayer.nodeCount() * myLayer.weightCount()};
+  return 0U < count ? static_cast<double>(myPrunedCount) / count : 0.0;
+}
+} // namespace ml::neural_network
@@ -0,0 +1,87 @@
+/**
+ * @brief Magnitude pruning of dense layer weights.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ctr/bit_vector.hpp"
+#include "ml/dense_layer/interface.hpp"
+#include "ml/types.hpp"
+
+namespace ml::neural_network {
+/**
+ * @brief Magnitude pruning of dense layer weights.
+ *
+ *        Sets the weights with the smallest magnitudes to zero and remembers
+ *        them in a mask, one bit per weight. Training keeps updating the
+ *        pruned weights, so apply() must be called after every update to
+ *        hold them at zero. Pruned weights stay pruned when the sparsity is
+ *        raised later, since their magnitude is zero. Biases are never
+ *        pruned.
+ */
+class Pruner final {
+public:
+  /**
+   * @brief Create a new pruner.
+   *
+   * @param[in] layer The layer to prune, must outlive the pruner.
+   */
+  explicit Pruner(ml::dense_layer::Interface &layer);
+
+  /**
+   * @brief Delete the pruner.
+   */
+  ~Pruner() noexcept = default;
+
+  /**
+   * @brief Prune the layer to the given sparsity.
+   *
+   * @param[in] sparsity The fraction of weights to prune, 0 - 1.
+   *
+   * @return True if the layer was pruned, or false on error.
+   */
+  bool prune(const double sparsity) noexcept;
+
+  /**
+   * @brief Set the pruned weights back to zero.
+   *
+   * @return True if the mask was applied or no weights are pruned, or false
+   *         on error.
+   */
+  bool apply() noexcept;
+
+  /**
+   * @brief Check whether any weights are pruned.
+   *
+   * @return True if any weights are pruned, or false if not.
+   */
+  bool isActive() const noexcept;
+
+  /**
+   * @brief Get the fraction of pruned weights.
+   *
+   * @return The fraction of pruned weights, 0 - 1.
+   */
+  double sparsity() const noexcept;
+
+  Pruner() = delete;                          // No default constructor.
+  Pruner(const Pruner &) = delete;            // No copy constructor.
+  Pruner(Pruner &&) = delete;                 // No move constructor.
+  Pruner &operator=(const Pruner &) = delete; // No copy assignment.
+  Pruner &operator=(Pruner &&) = delete;      // No move assignment.
+
+private:
+  /** Reference to the layer to prune. */
+  ml::dense_layer::Interface &myLayer;
+
+  /** Kept weights, bit i * weight count + j is set for kept weight [i][j]. */
+  ctr::BitVector myMask;
+
+  /** Masked copy of the weights, written back to the layer. */
+  ml::Matrix2d myWeights;
+
+  /** The number of pruned weights. */
+  size_t myPrunedCount;
+};
+} // namespace ml::neural_network
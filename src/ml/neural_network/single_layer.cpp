@@ -1,9 +1,13 @@
 /**
  * @brief Cpp-file for neural network functions
  */
+#include <math.h>
+
 #include "ml/neural_network/single_layer.hpp"
 #include "ctr/vector.hpp"
 #include "ml/dense_layer/interface.hpp"
+#include "ml/dense_layer/kernels.hpp"
+#include "ml/lr_schedule/constant.hpp"
 
 namespace ml::neural_network {
 
@@ -11,6 +15,13 @@ namespace {
 constexpr size_t min(const size_t x, const size_t y) noexcept {
   return x <= y ? x : y;
 }
+
+// Copy the values of a sample into an already allocated batch row.
+void copyValues(const ml::Matrix1d &source, ml::Matrix1d &target) noexcept {
+  for (size_t i{}; i < source.size(); ++i) {
+    target[i] = source[i];
+  }
+}
 } // namespace
 
 //--------------------------------------------------------------------------------//
@@ -19,9 +30,22 @@ SingleLayer::SingleLayer(ml::dense_layer::Interface &hiddenLayer,
                          const ml::Matrix2d &trainInput,
                          const ml::Matrix2d &trainOutput)
     : myHiddenLayer{hiddenLayer}, myOutputLayer{outputLayer},
-      myTrainInput{trainInput}, myTrainOutput{trainOutput},
-      myTrainSetCount(
-          static_cast<unsigned>(min(trainInput.size(), trainOutput.size()))) {}
+      myMemorySet{trainInput, trainOutput}, myTrainSet{myMemorySet},
+      myTrainSetCount(static_cast<unsigned>(myMemorySet.sampleCount())),
+      myHiddenPruner{hiddenLayer}, myOutputPruner{outputLayer},
+      myStopAccuracy{ml::ActFunc::Softmax == outputLayer.actFunc() ? 1.0
+                                                                   : 0.0} {}
+
+//--------------------------------------------------------------------------------//
+SingleLayer::SingleLayer(ml::dense_layer::Interface &hiddenLayer,
+                         ml::dense_layer::Interface &outputLayer,
+                         ml::dataset::Interface &trainSet)
+    : myHiddenLayer{hiddenLayer}, myOutputLayer{outputLayer}, myMemorySet{},
+      myTrainSet{trainSet},
+      myTrainSetCount(static_cast<unsigned>(trainSet.sampleCount())),
+      myHiddenPruner{hiddenLayer}, myOutputPruner{outputLayer},
+      myStopAccuracy{ml::ActFunc::Softmax == outputLayer.actFunc() ? 1.0
+                                                                   : 0.0} {}
 
 //--------------------------------------------------------------------------------//
 const ml::Matrix1d &SingleLayer::predict(const ml::Matrix1d &input) noexcept {
@@ -34,50 +58,461 @@ const ml::Matrix1d &SingleLayer::predict(const ml::Matrix1d &input) noexcept {
 }
 
 //--------------------------------------------------------------------------------//
-bool SingleLayer::train(double learningrate) noexcept {
-  if (0.0 >= learningrate) {
+bool SingleLayer::predict(ml::model::ActivationArena &arena,
+                          const ml::Matrix1d &input,
+                          ml::Matrix1d &output) const noexcept {
+  if ((input.size() != myHiddenLayer.weightCount()) ||
+      (output.size() < myOutputLayer.nodeCount()) ||
+      !arena.reserve(myHiddenLayer.nodeCount())) {
     return false;
   }
+  // Same as feedforward, but into the caller's buffers instead of the layers'.
+  ml::dense_layer::forward(myHiddenLayer, input, arena.values());
+  ml::dense_layer::forward(myOutputLayer, arena.values(), output);
+  return true;
+}
+
+//--------------------------------------------------------------------------------//
+size_t SingleLayer::predictClass(const ml::Matrix1d &input) noexcept {
+  return ml::dense_layer::argmax(predict(input));
+}
+
+//--------------------------------------------------------------------------------//
+bool SingleLayer::train(double learningrate, size_t batchSize,
+                        size_t maxEpochs) noexcept {
+  ml::lr_schedule::Constant schedule{learningrate};
+  return train(schedule, batchSize, maxEpochs);
+}
+
+//--------------------------------------------------------------------------------//
+bool SingleLayer::train(ml::lr_schedule::Interface &schedule,
+                        size_t batchSize, size_t maxEpochs) noexcept {
+  if ((0U == batchSize) || (0U == myTrainSetCount)) {
+    return false;
+  }
+  // Hard sampling skips single samples, a batch is trained as a whole.
+  if ((1U < batchSize) && (0U < myRecheckInterval)) {
+    return false;
+  }
+  if ((1U < batchSize) &&
+      (!ml::dense_layer::resizeZero(myBatchInput, batchSize,
+                                    myTrainSet.inputCount()) ||
+       !ml::dense_layer::resizeZero(myBatchReference, batchSize,
+                                    myTrainSet.outputCount()))) {
+    return false;
+  }
+
+  // Keep going until gradual pruning is done, even within tolerance.
+  for (size_t epoch{}; isPruning() || !isTrainingDone(); ++epoch) {
+    const double learningrate{schedule.rate()};
+    double loss{};
 
-  while (!isPredictDone()) {
-    for (size_t k{}; k < myTrainSetCount; k++) {
-      // (a) forward: hidden then output
-      if (!myHiddenLayer.feedforward(myTrainInput[k])) {
-        return false;
-      }
-      if (!myOutputLayer.feedforward(myHiddenLayer.output())) {
-        return false;
-      }
-
-      // (b) backprop: output with target, then hidden with next layer
-      if (!myOutputLayer.backpropagate(myTrainOutput[k])) {
-        return false;
-      }
-      if (!myHiddenLayer.backpropagate(myOutputLayer)) {
-        return false;
-      }
-
-      // (c) optimize: each layer with its own input source
-      if (!myHiddenLayer.optimize(myTrainInput[k], learningrate)) {
-        return false;
-      }
-      if (!myOutputLayer.optimize(myHiddenLayer.output(), learningrate)) {
-        return false;
-      }
+    if ((0U < maxEpochs) && (maxEpochs <= epoch)) {
+      return false;
+    }
+    if ((0.0 >= learningrate) || !pruneStep()) {
+      return false;
     }
+    if (1U < batchSize ? !trainBatches(learningrate, batchSize, loss)
+                       : !trainSamples(learningrate, loss)) {
+      return false;
+    }
+    // Advance the schedule with the mean loss of the epoch.
+    schedule.step(loss);
     ++myEpochsUsed;
   }
   return true;
 }
 
-bool SingleLayer::isPredictDone() noexcept {
+//--------------------------------------------------------------------------------//
+double SingleLayer::findLearningRate(double minRate, double maxRate,
+                                     size_t stepCount) noexcept {
+  if ((0.0 >= minRate) || (minRate >= maxRate) || (1U >= stepCount) ||
+      (0U == myTrainSetCount)) {
+    return 0.0;
+  }
+
+  // Snapshot the parameters, the test trains the network to destruction.
+  const ml::Matrix2d hiddenWeights{myHiddenLayer.weights()};
+  const ml::Matrix1d hiddenBias{myHiddenLayer.bias()};
+  const ml::Matrix2d outputWeights{myOutputLayer.weights()};
+  const ml::Matrix1d outputBias{myOutputLayer.bias()};
+
+  if ((hiddenWeights.size() != myHiddenLayer.nodeCount()) ||
+      (hiddenBias.size() != myHiddenLayer.nodeCount()) ||
+      (outputWeights.size() != myOutputLayer.nodeCount()) ||
+      (outputBias.size() != myOutputLayer.nodeCount())) {
+    return 0.0;
+  }
+  // The test visits every sample in dataset order, so neither the sampler
+  // nor the hard sampling state moves on.
+  auto *const sampler{mySampler};
+  const auto recheckInterval{myRecheckInterval};
+  mySampler = nullptr;
+  myRecheckInterval = 0U;
+
+  constexpr double smoothing{0.7};
+  constexpr double divergence{4.0};
+  const double growth{pow(maxRate / minRate, 1.0 / (stepCount - 1U))};
+
+  double learningrate{minRate};
+  double average{};
+  double bestLoss{};
+  double bestRate{};
+
+  for (size_t step{}; step < stepCount; ++step) {
+    double loss{};
+
+    if (!trainSamples(learningrate, loss)) {
+      break;
+    }
+
+    // Exponential moving average of the mean epoch loss, corrected for its
+    // zero start.
+    average = smoothing * average + (1.0 - smoothing) * loss;
+    const double smoothed{average / (1.0 - pow(smoothing, step + 1U))};
+
+    if (!isfinite(smoothed) ||
+        ((0.0 < bestRate) && (smoothed > divergence * bestLoss))) {
+      break;
+    }
+    if ((0.0 >= bestRate) || (smoothed < bestLoss)) {
+      bestLoss = smoothed;
+      bestRate = learningrate;
+    }
+    learningrate *= growth;
+  }
+  mySampler = sampler;
+  myRecheckInterval = recheckInterval;
+
+  // The optimizers start over as well, their state belongs to the test.
+  if (!myHiddenLayer.setParameters(hiddenWeights, hiddenBias) ||
+      !myOutputLayer.setParameters(outputWeights, outputBias) ||
+      !myHiddenLayer.resetOptimizer() || !myOutputLayer.resetOptimizer()) {
+    return 0.0;
+  }
+  // The loss minimum is already at the edge of stability, back off from it.
+  return bestRate / 10.0;
+}
+
+//--------------------------------------------------------------------------------//
+bool SingleLayer::trainSample(size_t k, double learningrate,
+                              double &loss) noexcept {
+  // Both stay valid for the whole sample, the set isn't read again.
+  const auto &input{myTrainSet.input(k)};
+  const auto &reference{myTrainSet.output(k)};
+
+  // (a) forward: hidden then output
+  if (!myHiddenLayer.feedforward(input)) {
+    return false;
+  }
+  if (!myOutputLayer.feedforward(myHiddenLayer.output())) {
+    return false;
+  }
+  loss = sampleLoss(myOutputLayer.output(), reference);
+
+  // With hard sampling, samples within tolerance aren't trained.
+  if (0U < myRecheckInterval) {
+    const bool converged{isConverged(myOutputLayer.output(), reference)};
+
+    myConverged.set(k, converged);
+    if (converged) {
+      return true;
+    }
+  }
+
+  // (b) backprop: output with target, then hidden with next layer
+  if (!myOutputLayer.backpropagate(reference)) {
+    return false;
+  }
+  if (!myHiddenLayer.backpropagate(myOutputLayer)) {
+    return false;
+  }
+
+  // (c) optimize: each layer with its own input source
+  if (!myHiddenLayer.optimize(input, learningrate)) {
+    return false;
+  }
+  if (!myOutputLayer.optimize(myHiddenLayer.output(), learningrate)) {
+    return false;
+  }
+  return applyMasks();
+}
+
+//--------------------------------------------------------------------------------//
+bool SingleLayer::trainSamples(double learningrate, double &loss) noexcept {
+  // With hard sampling, converged samples are only checked again every
+  // recheck interval.
+  const bool skipConverged{(0U < myRecheckInterval) &&
+                           (0U != myHardEpoch++ % myRecheckInterval)};
+  size_t trainedCount{};
+  nextEpoch();
+
+  for (size_t position{}; position < myTrainSetCount; position++) {
+    const auto k{sampleAt(position)};
+    const double weight{weightAt(position)};
+    double sampleLoss{};
+
+    // Samples without weight don't contribute at all.
+    if ((0.0 >= weight) || (skipConverged && myConverged.test(k))) {
+      continue;
+    }
+    if (!trainSample(k, learningrate * weight, sampleLoss)) {
+      return false;
+    }
+    loss += weight * sampleLoss;
+    ++trainedCount;
+  }
+  // Skipped samples add no loss, average over the trained ones only.
+  loss = 0U < trainedCount ? loss / trainedCount : 0.0;
+  return true;
+}
+
+//--------------------------------------------------------------------------------//
+bool SingleLayer::trainBatches(double learningrate, size_t batchSize,
+                               double &loss) noexcept {
+  size_t trainedCount{};
+  nextEpoch();
+
+  for (size_t begin{}; begin < myTrainSetCount; begin += batchSize) {
+    const auto count{min(batchSize, myTrainSetCount - begin)};
+    double weight{};
+
+    if (!loadBatch(begin, count, weight)) {
+      return false;
+    }
+    if (0.0 >= weight) {
+      continue;
+    }
+
+    // (a) forward: hidden then output, one matrix product per layer
+    if (!myHiddenLayer.feedforwardBatch(myBatchInput, count)) {
+      return false;
+    }
+    if (!myOutputLayer.feedforwardBatch(myHiddenLayer.batchOutput(), count)) {
+      return false;
+    }
+    for (size_t s{}; s < count; ++s) {
+      loss += weightAt(begin + s) * sampleLoss(myOutputLayer.batchOutput()[s],
+                                               myBatchReference[s]);
+    }
+    trainedCount += count;
+
+    // (b) backprop: output with targets, then hidden with next layer
+    if (!myOutputLayer.backpropagateBatch(myBatchReference)) {
+      return false;
+    }
+    if (!myHiddenLayer.backpropagateBatch(myOutputLayer)) {
+      return false;
+    }
+
+    // (c) optimize: one update per layer for the whole batch
+    if (!myHiddenLayer.optimizeBatch(myBatchInput, learningrate * weight)) {
+      return false;
+    }
+    if (!myOutputLayer.optimizeBatch(myHiddenLayer.batchOutput(),
+                                     learningrate * weight) ||
+        !applyMasks()) {
+      return false;
+    }
+  }
+  loss = 0U < trainedCount ? loss / trainedCount : 0.0;
+  return true;
+}
+
+//--------------------------------------------------------------------------------//
+bool SingleLayer::loadBatch(size_t begin, size_t count,
+                            double &weight) noexcept {
+  weight = 0.0;
+
+  for (size_t s{}; s < count; ++s) {
+    const auto k{sampleAt(begin + s)};
+    const auto &input{myTrainSet.input(k)};
+    const auto &reference{myTrainSet.output(k)};
+
+    weight += weightAt(begin + s) / count;
+
+    // Reject samples that don't fit the preallocated batch rows.
+    if ((input.size() != myBatchInput[s].size()) ||
+        (reference.size() != myBatchReference[s].size())) {
+      return false;
+    }
+    copyValues(input, myBatchInput[s]);
+    copyValues(reference, myBatchReference[s]);
+  }
+  return true;
+}
+
+//--------------------------------------------------------------------------------//
+void SingleLayer::nextEpoch() noexcept {
+  if (nullptr != mySampler) {
+    mySampler->nextEpoch();
+  }
+}
+
+//--------------------------------------------------------------------------------//
+size_t SingleLayer::sampleAt(size_t position) const noexcept {
+  return nullptr != mySampler ? mySampler->index(position) : position;
+}
+
+//--------------------------------------------------------------------------------//
+double SingleLayer::weightAt(size_t position) const noexcept {
+  return nullptr != mySampler ? mySampler->weight(position) : 1.0;
+}
+
+//--------------------------------------------------------------------------------//
+bool SingleLayer::setSampler(ml::dataset::Sampler &sampler) noexcept {
+  // The sampler must cover exactly the training set.
+  if (!sampler.init(myTrainSet) || (myTrainSetCount != sampler.size())) {
+    return false;
+  }
+  mySampler = &sampler;
+  return true;
+}
+
+//--------------------------------------------------------------------------------//
+bool SingleLayer::setHardSampling(size_t recheckInterval) noexcept {
+  myRecheckInterval = 0U;
+  myHardEpoch = 0U;
+
+  if (0U == recheckInterval) {
+    myConverged.clear();
+    return true;
+  }
+  if (!myConverged.resize(myTrainSetCount)) {
+    return false;
+  }
+  // Start as converged, so the first epoch checks every sample.
+  for (size_t k{}; k < myTrainSetCount; ++k) {
+    myConverged.set(k);
+  }
+  myRecheckInterval = recheckInterval;
+  return true;
+}
+
+//--------------------------------------------------------------------------------//
+bool SingleLayer::isTrainingDone() noexcept {
+  // Too few samples within tolerance when last seen means more training, no
+  // need to check the whole set.
+  const double required{0.0 < myStopAccuracy ? myStopAccuracy : 1.0};
+
+  if ((0U < myRecheckInterval) &&
+      (myConverged.count() < required * myTrainSetCount)) {
+    return false;
+  }
+  return isPredictDone();
+}
+
+//--------------------------------------------------------------------------------//
+bool SingleLayer::isConverged(const ml::Matrix1d &output,
+                              const ml::Matrix1d &reference) const noexcept {
+  using ml::dense_layer::argmax;
 
-  constexpr double tol = 1e-1;
+  return 0.0 < myStopAccuracy
+             ? argmax(output) == argmax(reference)
+             : ml::dense_layer::isCorrect(myOutputLayer, output, reference);
+}
+
+//--------------------------------------------------------------------------------//
+double SingleLayer::sampleLoss(const ml::Matrix1d &output,
+                               const ml::Matrix1d &reference) const noexcept {
+  // Softmax outputs are trained with the cross-entropy loss.
+  return ml::dense_layer::sampleLoss(myOutputLayer, output, reference);
+}
+
+//--------------------------------------------------------------------------------//
+bool SingleLayer::setStopAccuracy(double accuracy) noexcept {
+  if ((0.0 > accuracy) || (1.0 < accuracy)) {
+    return false;
+  }
+  myStopAccuracy = accuracy;
+  return true;
+}
 
+//--------------------------------------------------------------------------------//
+double SingleLayer::accuracy() noexcept {
+  size_t correctCount{};
+
+  if (0U == myTrainSetCount) {
+    return 0.0;
+  }
   for (size_t i{}; i < myTrainSetCount; ++i) {
-    const double pred = predict(myTrainInput[i])[0];
-    const double target = myTrainOutput[i][0];
-    if (abs(pred - target) > tol) {
+    // The class stays valid while the reference is fetched.
+    const auto predicted{predictClass(myTrainSet.input(i))};
+
+    if (predicted == ml::dense_layer::argmax(myTrainSet.output(i))) {
+      ++correctCount;
+    }
+  }
+  return static_cast<double>(correctCount) / myTrainSetCount;
+}
+
+//--------------------------------------------------------------------------------//
+bool SingleLayer::prune(double sparsity) noexcept {
+  return myHiddenPruner.prune(sparsity) && myOutputPruner.prune(sparsity);
+}
+
+//--------------------------------------------------------------------------------//
+bool SingleLayer::setPruning(double targetSparsity, size_t pruneEpochs,
+                             size_t pruneInterval) noexcept {
+  if ((0.0 > targetSparsity) || (1.0 < targetSparsity) ||
+      (0U == pruneInterval)) {
+    return false;
+  }
+  myTargetSparsity = targetSparsity;
+  myPruneEpochs = pruneEpochs;
+  myPruneInterval = pruneInterval;
+  myPruneStart = static_cast<size_t>(myEpochsUsed);
+  return true;
+}
+
+//--------------------------------------------------------------------------------//
+double SingleLayer::sparsity() const noexcept {
+  const double hiddenCount{static_cast<double>(myHiddenLayer.nodeCount() *
+                                               myHiddenLayer.weightCount())};
+  const double outputCount{static_cast<double>(myOutputLayer.nodeCount() *
+                                               myOutputLayer.weightCount())};
+  return (myHiddenPruner.sparsity() * hiddenCount +
+          myOutputPruner.sparsity() * outputCount) /
+         (hiddenCount + outputCount);
+}
+
+//--------------------------------------------------------------------------------//
+bool SingleLayer::isPruning() const noexcept {
+  return (0.0 < myTargetSparsity) &&
+         (static_cast<size_t>(myEpochsUsed) - myPruneStart <= myPruneEpochs);
+}
+
+//--------------------------------------------------------------------------------//
+bool SingleLayer::pruneStep() noexcept {
+  const size_t epoch{static_cast<size_t>(myEpochsUsed) - myPruneStart};
+
+  if (!isPruning() ||
+      ((0U != epoch % myPruneInterval) && (epoch != myPruneEpochs))) {
+    return true;
+  }
+  // Cubic ramp from 0 to the target, reached at the last pruning epoch.
+  const double remaining{
+      0U < myPruneEpochs ? 1.0 - static_cast<double>(epoch) / myPruneEpochs
+                         : 0.0};
+  return prune(myTargetSparsity * (1.0 - remaining * remaining * remaining));
+}
+
+//--------------------------------------------------------------------------------//
+bool SingleLayer::applyMasks() noexcept {
+  return myHiddenPruner.apply() && myOutputPruner.apply();
+}
+
+//--------------------------------------------------------------------------------//
+bool SingleLayer::isPredictDone() noexcept {
+  if (0.0 < myStopAccuracy) {
+    return accuracy() >= myStopAccuracy;
+  }
+  for (size_t i{}; i < myTrainSetCount; ++i) {
+    // The prediction stays valid while the reference is fetched.
+    const auto &prediction{predict(myTrainSet.input(i))};
+
+    if (!isConverged(prediction, myTrainSet.output(i))) {
       return false;
     }
   }
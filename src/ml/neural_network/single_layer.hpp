@@ -3,9 +3,16 @@
  */
 #pragma once
 
+#include "ctr/bit_vector.hpp"
 #include "ctr/vector.hpp"
+#include "ml/dataset/interface.hpp"
+#include "ml/dataset/memory_dataset.hpp"
+#include "ml/dataset/sampler.hpp"
 #include "ml/dense_layer/interface.hpp"
+#include "ml/lr_schedule/interface.hpp"
+#include "ml/model/activation_arena.hpp"
 #include "ml/neural_network/interface.hpp"
+#include "ml/neural_network/pruner.hpp"
 
 namespace ml::neural_network {
 
@@ -26,6 +33,21 @@ public:
                        const ml::Matrix2d &trainInput,
                        const ml::Matrix2d &trainOutput);
 
+  /**
+   * @brief Constructor SignleLayer with a training dataset.
+   *
+   * The samples are pulled from the dataset one at a time, so the training set
+   * doesn't need to fit the heap.
+   *
+   * @param [in] hidden The hidden layer in the neural network.
+   * @param [in] output The output layer in the neural network.
+   * @param [in] trainSet The dataset the model should train on, must outlive
+   * the network.
+   */
+  explicit SingleLayer(ml::dense_layer::Interface &hiddenLayer,
+                       ml::dense_layer::Interface &outputLayer,
+                       ml::dataset::Interface &trainSet);
+
   /**
    * @brief Delete the constructor
    */
@@ -41,19 +63,194 @@ public:
    */
   const ml::Matrix1d &predict(const ml::Matrix1d &input) noexcept override;
 
+  /**
+   * @brief Reentrant prediction method to predict the network
+   *
+   * The layers are only read, the hidden activations live in the arena, so
+   * any number of callers can predict concurrently, each with its own arena.
+   * The prediction uses the full precision parameters, and must not run
+   * while the network is trained.
+   *
+   * @param [in, out] arena The caller's arena, grows to the hidden layer size
+   * on first use.
+   * @param [in] input Reference to a double vector containing
+   * the data the prediction should be based on.
+   * @param [out] output The predicted values, must hold one value per output
+   * node.
+   *
+   * @return True if the output was predicted, or false if the sizes don't
+   * match or on allocation failure.
+   */
+  bool predict(ml::model::ActivationArena &arena, const ml::Matrix1d &input,
+               ml::Matrix1d &output) const noexcept;
+
+  /**
+   * @brief Predict the class of the input.
+   *
+   * Meant for softmax output layers trained on one-hot references, where the
+   * largest output is the most probable class.
+   *
+   * @param [in] input Reference to a double vector containing
+   * the data the prediction should be based on.
+   *
+   * @return The index of the largest output.
+   */
+  size_t predictClass(const ml::Matrix1d &input) noexcept;
+
   /**
    * @brief Train the model.
    *
    * @param [in] learningRate The speed the model should correct the errors in,
    * 0.01 as default.
+   * @param [in] batchSize The number of samples per update, 1 as default.
+   * Batches above 1 run feedforward and backpropagation as matrix-matrix
+   * products and apply the mean gradient once per batch.
+   * @param [in] maxEpochs The maximum number of epochs to train, 0 (default)
+   * for no limit.
+   *
+   * @return True if traingen is done, or False on error or if the epoch limit
+   * was reached.
+   */
+  bool train(double learningrate = 0, size_t batchSize = 1U,
+             size_t maxEpochs = 0U) noexcept;
+
+  /**
+   * @brief Train the model with a learning rate schedule.
+   *
+   * @param [in] schedule The schedule providing the learning rate of each
+   * epoch. It is advanced once per epoch with the mean loss of the samples
+   * trained in the epoch.
+   * @param [in] batchSize The number of samples per update, 1 as default.
+   * @param [in] maxEpochs The maximum number of epochs to train, 0 (default)
+   * for no limit.
+   *
+   * @return True if traingen is done, or False on error or if the epoch limit
+   * was reached.
+   */
+  bool train(ml::lr_schedule::Interface &schedule, size_t batchSize = 1U,
+             size_t maxEpochs = 0U) noexcept;
+
+  /**
+   * @brief Find a suitable learning rate with a range test.
+   *
+   * Runs one epoch per step while the learning rate grows exponentially from
+   * the minimum to the maximum rate and tracks the smoothed training loss.
+   * The test stops early once the loss diverges. It visits the samples in
+   * dataset order without hard sampling, so the sampler and the hard
+   * sampling state are left as they were. The parameters are restored and
+   * the state of attached optimizers is reset afterwards.
+   *
+   * @param [in] minRate The learning rate of the first step, 1e-4 as default.
+   * @param [in] maxRate The learning rate of the last step, 1 as default.
+   * @param [in] stepCount The number of steps, 50 as default.
+   *
+   * @return A tenth of the rate with the lowest smoothed loss, or 0 on error.
+   */
+  double findLearningRate(double minRate = 1e-4, double maxRate = 1.0,
+                          size_t stepCount = 50U) noexcept;
+
+  /**
+   * @brief Visit the samples in the order of the given sampler.
+   *
+   * The sampler is prepared for the training set and generates a new order
+   * every epoch. Its sample weights scale the learning rate of each sample,
+   * batches use the mean weight of their samples. Without a sampler, the
+   * samples are visited in dataset order. Set the sample weights after this
+   * call, preparing the sampler clears them.
+   *
+   * @param [in] sampler The sampler to use, must outlive the network.
+   *
+   * @return True if the sampler was set, or False on error.
+   */
+  bool setSampler(ml::dataset::Sampler &sampler) noexcept;
+
+  /**
+   * @brief Train only on the samples that aren't within tolerance yet.
+   *
+   * A sample within tolerance after its forward pass is marked as converged
+   * and skips backpropagation and the update. Converged samples are skipped
+   * completely until the next recheck epoch, in which every sample is
+   * checked again, so samples that drift out of tolerance are trained again.
+   * Late epochs only touch the few hard samples. Only training sample by
+   * sample is supported, train() fails with a batch size above 1.
+   *
+   * @param [in] recheckInterval The number of epochs between checks of all
+   * samples, 10 as default. 0 trains on every sample again.
+   *
+   * @return True if hard sample training was set, or False on allocation
+   * failure.
+   */
+  bool setHardSampling(size_t recheckInterval = 10U) noexcept;
+
+  /**
+   * @brief Prune the weights with the smallest magnitudes at once.
+   *
+   * Both layers are pruned to the given sparsity. The pruned weights are held
+   * at zero by all following training, which fine-tunes the remaining ones.
+   *
+   * @param [in] sparsity The fraction of weights to prune per layer, 0 - 1.
+   *
+   * @return True if the layers were pruned, or False on error.
+   */
+  bool prune(double sparsity) noexcept;
+
+  /**
+   * @brief Prune gradually during the following training.
+   *
+   * The sparsity rises from 0 to the target over the given number of epochs
+   * as s = target * (1 - (1 - t / pruneEpochs)^3), which prunes most weights
+   * early while the network can still recover from it. Training doesn't stop
+   * before the target is reached and then continues with fixed masks until
+   * the predictions are within tolerance.
+   *
+   * @param [in] targetSparsity The fraction of weights to prune per layer,
+   * 0 - 1.
+   * @param [in] pruneEpochs The number of epochs to reach the target, 100 as
+   * default. 0 prunes to the target at once.
+   * @param [in] pruneInterval The number of epochs between pruning steps, 10
+   * as default.
+   *
+   * @return True if pruning was set up, or False on invalid parameters.
+   */
+  bool setPruning(double targetSparsity, size_t pruneEpochs = 100U,
+                  size_t pruneInterval = 10U) noexcept;
+
+  /**
+   * @brief Get the fraction of pruned weights of both layers.
    *
-   * @return True if traingen is done, or False if not.
+   * @return The fraction of pruned weights, 0 - 1.
    */
-  bool train(double learningrate = 0) noexcept;
+  double sparsity() const noexcept;
+
+  /**
+   * @brief Stop training once enough training samples are classified right.
+   *
+   * A sample is classified right if its largest output matches its largest
+   * reference. This replaces the tolerance check of every output, which
+   * would keep training a classifier long after its decisions are right.
+   * Hard sampling skips the samples classified right. Networks with a
+   * softmax output layer stop at an accuracy of 1 by default.
+   *
+   * @param [in] accuracy The fraction of samples to classify right, 0 - 1.
+   * 0 checks every sample with ml::dense_layer::isCorrect() instead.
+   *
+   * @return True if the stop criterion was set, or False on invalid accuracy.
+   */
+  bool setStopAccuracy(double accuracy) noexcept;
+
+  /**
+   * @brief Get the fraction of training samples classified right.
+   *
+   * @return The accuracy on the training set, 0 - 1.
+   */
+  double accuracy() noexcept;
 
   /**
    * @brief Check if the prediction is within tolerance for the training set.
    *
+   * With a stop accuracy, the accuracy on the training set is checked
+   * instead.
+   *
    * @return True if prediction is done, or False if not.
    */
   bool isPredictDone() noexcept;
@@ -79,11 +276,41 @@ private:
       &myHiddenLayer; // Reference for the hiddenlayer from the interface.
   ml::dense_layer::Interface
       &myOutputLayer; // Reference for the outputlayer from the interface.
-  const ml::Matrix2d &myTrainInput;  // Reference to the traininginput.
-  const ml::Matrix2d &myTrainOutput; // Reference to the trainingoutput.
+  ml::dataset::MemoryDataset myMemorySet; // Wraps the training matrices.
+  ml::dataset::Interface &myTrainSet;     // Reference to the training set.
   const unsigned
       myTrainSetCount; // Indicates the amount of trainingsetups avalible.
   int myEpochsUsed{0}; // To save the amount of epochs used.
+  ml::dataset::Sampler *mySampler{nullptr}; // Sample order, null if unused.
+  ml::Matrix2d myBatchInput;     // Training inputs of the current batch.
+  ml::Matrix2d myBatchReference; // Training outputs of the current batch.
+  Pruner myHiddenPruner;         // Pruning mask of the hidden layer.
+  Pruner myOutputPruner;         // Pruning mask of the output layer.
+  double myTargetSparsity{};     // Target of gradual pruning, 0 if unused.
+  size_t myPruneEpochs{};        // Epochs to reach the target sparsity.
+  size_t myPruneInterval{1U};    // Epochs between gradual pruning steps.
+  size_t myPruneStart{};         // Epoch gradual pruning started at.
+  ctr::BitVector myConverged;    // Samples within tolerance when last seen.
+  size_t myRecheckInterval{};    // Epochs between checks of all samples.
+  size_t myHardEpoch{};          // Epochs trained with hard sampling.
+  double myStopAccuracy{};       // Accuracy to stop at, 0 for tolerance.
+
+  bool trainSample(size_t k, double learningrate, double &loss) noexcept;
+  bool trainSamples(double learningrate, double &loss) noexcept;
+  bool trainBatches(double learningrate, size_t batchSize,
+                    double &loss) noexcept;
+  bool loadBatch(size_t begin, size_t count, double &weight) noexcept;
+  void nextEpoch() noexcept;
+  size_t sampleAt(size_t position) const noexcept;
+  double weightAt(size_t position) const noexcept;
+  bool isConverged(const ml::Matrix1d &output,
+                   const ml::Matrix1d &reference) const noexcept;
+  double sampleLoss(const ml::Matrix1d &output,
+                    const ml::Matrix1d &reference) const noexcept;
+  bool isTrainingDone() noexcept;
+  bool isPruning() const noexcept;
+  bool pruneStep() noexcept;
+  bool applyMasks() noexcept;
 };
 
 } // namespace ml::neural_network
@@ -0,0 +1,168 @@
+/**
+ * @brief Width shrinker implementation details.
+ */
+#include <math.h>
+
+#include <zephyr/sys/printk.h>
+
+#include "ml/dense_layer/kernels.hpp"
+#include "ml/neural_network/single_layer.hpp"
+#include "ml/neural_network/width_shrinker.hpp"
+
+namespace ml::neural_network {
+namespace {
+// -----------------------------------------------------------------------------
+bool copyParameters(const ml::dense_layer::Interface &layer,
+                    ml::Matrix2d &weights, ml::Matrix1d &bias) noexcept {
+  weights = layer.weights();
+  bias = layer.bias();
+  return (weights.size() == layer.nodeCount()) &&
+         (bias.size() == layer.nodeCount());
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+WidthShrinker::WidthShrinker(ml::dense_layer::DenseLayer &hiddenLayer,
+                             ml::dense_layer::DenseLayer &outputLayer,
+                             const ml::Matrix2d &trainInput,
+                             const ml::Matrix2d &trainOutput)
+    : myHiddenLayer{hiddenLayer}, myOutputLayer{outputLayer},
+      myTrainInput{trainInput}, myTrainOutput{trainOutput}, myHiddenWeights{},
+      myOutputWeights{}, myHiddenBias{}, myOutputBias{}, mySaliency{},
+      myMeanOutput{}, myRemovedCount{} {}
+
+// -----------------------------------------------------------------------------
+bool WidthShrinker::shrink(const double learningRate,
+                           const size_t retrainEpochs,
+                           const size_t minWidth) noexcept {
+  if ((0.0 >= learningRate) || (0U == minWidth)) {
+    return false;
+  }
+  SingleLayer network{myHiddenLayer, myOutputLayer, myTrainInput,
+                      myTrainOutput};
+  myRemovedCount = 0U;
+
+  if (!network.isPredictDone()) {
+    printk("network not within tolerance, train it first\n");
+    return false;
+  }
+
+  while (minWidth < myHiddenLayer.nodeCount()) {
+    // Keep the passing network in case the smaller one doesn't pass.
+    if (!copyParameters(myHiddenLayer, myHiddenWeights, myHiddenBias) ||
+        !copyParameters(myOutputLayer, myOutputWeights, myOutputBias)) {
+      printk("failed to allocate shrinker buffers\n");
+      return false;
+    }
+    if (!computeSaliency() || !removeNode(leastSalient())) {
+      return false;
+    }
+    // Retrain briefly, the folded bias often keeps it within tolerance.
+    if (!network.isPredictDone() &&
+        !network.train(learningRate, 1U, retrainEpochs)) {
+      return restore();
+    }
+    ++myRemovedCount;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+size_t WidthShrinker::removedCount() const noexcept { return myRemovedCount; }
+
+// -----------------------------------------------------------------------------
+bool WidthShrinker::computeSaliency() noexcept {
+  using namespace ml::dense_layer;
+  const auto nodeCount{myHiddenLayer.nodeCount()};
+  const auto sampleCount{myTrainInput.size()};
+  ml::Matrix1d output(nodeCount);
+
+  if ((output.size() != nodeCount) || !resizeZero(mySaliency, nodeCount) ||
+      !resizeZero(myMeanOutput, nodeCount)) {
+    printk("failed to allocate shrinker buffers\n");
+    return false;
+  }
+
+  // Mean and mean magnitude of every hidden output over the training set.
+  for (size_t k{}; k < sampleCount; ++k) {
+    forward(myHiddenLayer, myTrainInput[k], output);
+
+    for (size_t i{}; i < nodeCount; ++i) {
+      myMeanOutput[i] += output[i] / sampleCount;
+      mySaliency[i] += fabs(output[i]) / sampleCount;
+    }
+  }
+
+  // Scale by how strongly each node drives the outputs.
+  for (size_t i{}; i < nodeCount; ++i) {
+    double weightSum{};
+
+    for (const auto &nodeWeights : myOutputLayer.weights()) {
+      weightSum += fabs(nodeWeights[i]);
+    }
+    mySaliency[i] *= weightSum;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+size_t WidthShrinker::leastSalient() const noexcept {
+  size_t index{};
+
+  for (size_t i{1U}; i < mySaliency.size(); ++i) {
+    if (mySaliency[i] < mySaliency[index]) {
+      index = i;
+    }
+  }
+  return index;
+}
+
+// -----------------------------------------------------------------------------
+bool WidthShrinker::removeNode(const size_t index) noexcept {
+  using ml::dense_layer::resizeZero;
+  const auto nodeCount{myHiddenLayer.nodeCount() - 1U};
+  const auto inputCount{myHiddenLayer.weightCount()};
+  const auto outputCount{myOutputLayer.nodeCount()};
+
+  ml::Matrix2d hiddenWeights{}, outputWeights{};
+  ml::Matrix1d hiddenBias{}, outputBias{};
+
+  if (!resizeZero(hiddenWeights, nodeCount, inputCount) ||
+      !resizeZero(hiddenBias, nodeCount) ||
+      !resizeZero(outputWeights, outputCount, nodeCount) ||
+      !resizeZero(outputBias, outputCount)) {
+    printk("failed to allocate shrinker buffers\n");
+    return false;
+  }
+
+  // Copy every hidden node but the removed one.
+  for (size_t i{}, target{}; i <= nodeCount; ++i) {
+    if (index == i) {
+      continue;
+    }
+    hiddenBias[target] = myHiddenBias[i];
+
+    for (size_t j{}; j < inputCount; ++j) {
+      hiddenWeights[target][j] = myHiddenWeights[i][j];
+    }
+    for (size_t k{}; k < outputCount; ++k) {
+      outputWeights[k][target] = myOutputWeights[k][i];
+    }
+    ++target;
+  }
+
+  // The removed node's mean contribution moves into the output bias.
+  for (size_t k{}; k < outputCount; ++k) {
+    outputBias[k] =
+        myOutputBias[k] + myOutputWeights[k][index] * myMeanOutput[index];
+  }
+  return myHiddenLayer.reshape(hiddenWeights, hiddenBias) &&
+         myOutputLayer.reshape(outputWeights, outputBias);
+}
+
+// -----------------------------------------------------------------------------
+bool WidthShrinker::restore() noexcept {
+  return myHiddenLayer.reshape(myHiddenWeights, myHiddenBias) &&
+         myOutputLayer.reshape(myOutputWeights, myOutputBias);
+}
+} // namespace ml::neural_network
@@ -0,0 +1,104 @@
+/**
+ * @brief Hidden layer width reduction for single layer neural networks.
+ */
+#pragma once
+
+#include <stddef.h>
+
+#include "ml/dense_layer/dense_layer.hpp"
+#include "ml/types.hpp"
+
+namespace ml::neural_network {
+/**
+ * @brief Hidden layer width reduction for single layer neural networks.
+ *
+ *        Starts from a trained network with an oversized hidden layer and
+ *        removes one hidden node at a time, the one with the lowest saliency:
+ *
+ *        saliency[i] = mean(|hidden_output[i]|) * sum(|output_weight[k][i]|)
+ *
+ *        i.e. the typical size of the node's contribution to the outputs. Its
+ *        mean contribution is folded into the output bias, then the network
+ *        is retrained for a few epochs. Once a removal can't be brought back
+ *        within tolerance, the last passing network is restored.
+ *
+ *        The layers are reshaped in place, so the result is a physically
+ *        smaller network that needs no sparse kernels.
+ */
+class WidthShrinker final {
+public:
+  /**
+   * @brief Create a new shrinker.
+   *
+   * @param[in] hiddenLayer The hidden layer in the neural network.
+   * @param[in] outputLayer The output layer in the neural network.
+   * @param[in] trainInput The input data that the model was trained with.
+   * @param[in] trainOutput The output data that the model was trained to
+   *                        predict.
+   */
+  explicit WidthShrinker(ml::dense_layer::DenseLayer &hiddenLayer,
+                         ml::dense_layer::DenseLayer &outputLayer,
+                         const ml::Matrix2d &trainInput,
+                         const ml::Matrix2d &trainOutput);
+
+  /**
+   * @brief Delete the shrinker.
+   */
+  ~WidthShrinker() noexcept = default;
+
+  /**
+   * @brief Shrink the hidden layer to the smallest width within tolerance.
+   *
+   * @param[in] learningRate The learning rate to retrain with. Must exceed 0.
+   * @param[in] retrainEpochs The maximum number of epochs to retrain after
+   *                          each removal (default = 200).
+   * @param[in] minWidth The smallest width to try (default = 1).
+   *
+   * @return True if the network was shrunk as far as possible, or false on
+   *         error or if the network wasn't within tolerance to begin with.
+   */
+  bool shrink(const double learningRate, const size_t retrainEpochs = 200U,
+              const size_t minWidth = 1U) noexcept;
+
+  /**
+   * @brief Get the number of hidden nodes removed by the last shrink.
+   *
+   * @return The number of removed hidden nodes.
+   */
+  size_t removedCount() const noexcept;
+
+  WidthShrinker() = delete;                                 // No default.
+  WidthShrinker(const WidthShrinker &) = delete;            // No copy.
+  WidthShrinker(WidthShrinker &&) = delete;                 // No move.
+  WidthShrinker &operator=(const WidthShrinker &) = delete; // No copy.
+  WidthShrinker &operator=(WidthShrinker &&) = delete;      // No move.
+
+private:
+  bool computeSaliency() noexcept;
+  size_t leastSalient() const noexcept;
+  bool removeNode(const size_t index) noexcept;
+  bool restore() noexcept;
+
+  /** Reference to the hidden layer. */
+  ml::dense_layer::DenseLayer &myHiddenLayer;
+
+  /** Reference to the output layer. */
+  ml::dense_layer::DenseLayer &myOutputLayer;
+
+  /** Reference to the training input. */
+  const ml::Matrix2d &myTrainInput;
+
+  /** Reference to the training output. */
+  const ml::Matrix2d &myTrainOutput;
+
+  /** Parameters of the last network within tolerance. */
+  ml::Matrix2d myHiddenWeights, myOutputWeights;
+  ml::Matrix1d myHiddenBias, myOutputBias;
+
+  /** Saliency and mean absolute output of each hidden node. */
+  ml::Matrix1d mySaliency, myMeanOutput;
+
+  /** The number of removed hidden nodes. */
+  size_t myRemovedCount;
+};
+} // namespace ml::neural_network
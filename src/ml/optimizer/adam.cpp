@@ -0,0 +1,76 @@
+/**
+ * @brief Adam optimizer implementation details.
+ */
+#include <math.h>
+
+#include <zephyr/sys/printk.h>
+
+#include "ml/dense_layer/kernels.hpp"
+#include "ml/optimizer/adam.hpp"
+
+namespace ml::optimizer {
+// -----------------------------------------------------------------------------
+Adam::Adam(const double beta1, const double beta2,
+           const double epsilon) noexcept
+    : myWeightMean{}, myWeightSquare{}, myBiasMean{}, myBiasSquare{},
+      myBeta1{beta1}, myBeta2{beta2}, myEpsilon{epsilon}, myBeta1Power{1.0},
+      myBeta2Power{1.0} {}
+
+// -----------------------------------------------------------------------------
+bool Adam::init(const size_t nodeCount, const size_t weightCount) noexcept {
+  using ml::dense_layer::resizeZero;
+
+  // Both moments start at zero, which the bias correction compensates for.
+  myBeta1Power = 1.0;
+  myBeta2Power = 1.0;
+  return resizeZero(myWeightMean, nodeCount, weightCount) &&
+         resizeZero(myWeightSquare, nodeCount, weightCount) &&
+         resizeZero(myBiasMean, nodeCount) &&
+         resizeZero(myBiasSquare, nodeCount);
+}
+
+// -----------------------------------------------------------------------------
+bool Adam::update(ml::Matrix2d &weights, ml::Matrix1d &bias,
+                  const ml::Matrix2d &weightGradient,
+                  const ml::Matrix1d &biasGradient,
+                  const double learningRate) noexcept {
+  // Make sure the state was allocated for a layer of this size.
+  if (bias.size() != myBiasMean.size()) {
+    printk("optimizer state mismatch: expected %u actual %u\n",
+           (unsigned)myBiasMean.size(), (unsigned)bias.size());
+    return false;
+  }
+  myBeta1Power *= myBeta1;
+  myBeta2Power *= myBeta2;
+
+  for (size_t i{}; i < bias.size(); ++i) {
+    bias[i] +=
+        learningRate * step(myBiasMean[i], myBiasSquare[i], biasGradient[i]);
+
+    for (size_t j{}; j < weights[i].size(); ++j) {
+      weights[i][j] += learningRate * step(myWeightMean[i][j],
+                                           myWeightSquare[i][j],
+                                           weightGradient[i][j]);
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+size_t Adam::stateBytes() const noexcept {
+  const auto weightCount{myWeightMean.empty() ? 0U : myWeightMean[0].size()};
+  return requiredBytes(myBiasMean.size(), weightCount);
+}
+
+// -----------------------------------------------------------------------------
+double Adam::step(double &mean, double &square,
+                  const double gradient) const noexcept {
+  // Update both moments, then correct them for their zero start values.
+  mean = myBeta1 * mean + (1.0 - myBeta1) * gradient;
+  square = myBeta2 * square + (1.0 - myBeta2) * gradient * gradient;
+
+  const auto meanHat{mean / (1.0 - myBeta1Power)};
+  const auto squareHat{square / (1.0 - myBeta2Power)};
+  return meanHat / (sqrt(squareHat) + myEpsilon);
+}
+} // namespace ml::optimizer
@@ -0,0 +1,120 @@
+/**
+ * @brief Adam optimizer implementation.
+ */
+#pragma once
+
+#include "ml/optimizer/interface.hpp"
+#include "ml/types.hpp"
+
+namespace ml::optimizer {
+/**
+ * @brief Adam, gradient descent with bias-corrected first and second moment
+ *        estimates.
+ *
+ *        mean = beta1 * mean + (1 - beta1) * gradient
+ *        square = beta2 * square + (1 - beta2) * gradient²
+ *        parameter += learning_rate * mean' / (sqrt(square') + epsilon)
+ *
+ *        where mean' and square' are corrected for their zero start values.
+ */
+class Adam final : public Interface {
+public:
+  /**
+   * @brief Create a new Adam optimizer.
+   *
+   * @param[in] beta1 The decay rate of the first moment (default = 0.9).
+   * @param[in] beta2 The decay rate of the second moment (default = 0.999).
+   * @param[in] epsilon Small value to avoid division by zero
+   *                    (default = 1e-8).
+   */
+  explicit Adam(const double beta1 = 0.9, const double beta2 = 0.999,
+                const double epsilon = 1e-8) noexcept;
+
+  /**
+   * @brief Delete the optimizer.
+   */
+  ~Adam() noexcept override = default;
+
+  /**
+   * @brief Get the state size of a layer of given dimensions.
+   *
+   * @param[in] nodeCount The number of nodes in the layer.
+   * @param[in] weightCount The number of weights per node in the layer.
+   *
+   * @return The number of bytes of state values (two moments per parameter).
+   */
+  static constexpr size_t requiredBytes(const size_t nodeCount,
+                                        const size_t weightCount) noexcept {
+    return 2U * nodeCount * (weightCount + 1U) * sizeof(double);
+  }
+
+  /**
+   * @brief Allocate and reset the state for a layer of given dimensions.
+   *
+   * @param[in] nodeCount The number of nodes in the layer.
+   * @param[in] weightCount The number of weights per node in the layer.
+   *
+   * @return True if the state was allocated, or false on error.
+   */
+  bool init(const size_t nodeCount, const size_t weightCount) noexcept override;
+
+  /**
+   * @brief Update the parameters of a layer with the given gradients.
+   *
+   * @param[in, out] weights The weights to update, [node][weight].
+   * @param[in, out] bias The bias values to update, [node].
+   * @param[in] weightGradient Weight gradients, [node][weight].
+   * @param[in] biasGradient Bias gradients, [node].
+   * @param[in] learningRate Learning rate to use for the update.
+   *
+   * @return True if the parameters were updated, or false on error.
+   */
+  bool update(ml::Matrix2d &weights, ml::Matrix1d &bias,
+              const ml::Matrix2d &weightGradient,
+              const ml::Matrix1d &biasGradient,
+              const double learningRate) noexcept override;
+
+  /**
+   * @brief Get the size of the per-parameter state.
+   *
+   * @return The number of bytes of state values currently allocated.
+   */
+  size_t stateBytes() const noexcept override;
+
+  Adam(const Adam &) = delete;            // No copy constructor.
+  Adam(Adam &&) = delete;                 // No move constructor.
+  Adam &operator=(const Adam &) = delete; // No copy assignment.
+  Adam &operator=(Adam &&) = delete;      // No move assignment.
+
+private:
+  double step(double &mean, double &square,
+              const double gradient) const noexcept;
+
+  /** First moment of the weight gradients: [node][weight]. */
+  ml::Matrix2d myWeightMean;
+
+  /** Second moment of the weight gradients: [node][weight]. */
+  ml::Matrix2d myWeightSquare;
+
+  /** First moment of the bias gradients. */
+  ml::Matrix1d myBiasMean;
+
+  /** Second moment of the bias gradients. */
+  ml::Matrix1d myBiasSquare;
+
+  /** The decay rate of the first moment. */
+  const double myBeta1;
+
+  /** The decay rate of the second moment. */
+  const double myBeta2;
+
+  /** Small value to avoid division by zero. */
+  const double myEpsilon;
+
+  /** beta1 ^ t, where t is the number of updates done. */
+  double myBeta1Power;
+
+  /** beta2 ^ t, where t is the number of updates done. */
+  double myBeta2Power;
+};
+} // namespace ml::optimizer
@@ -0,0 +1,59 @@
+/**
+ * @brief Optimizer interface.
+ */
+#pragma once
+
+#include "ml/types.hpp"
+
+namespace ml::optimizer {
+/**
+ * @brief Optimizer interface.
+ *
+ *        An optimizer instance owns the per-parameter state of exactly one
+ *        dense layer and turns gradients into parameter updates.
+ */
+class Interface {
+public:
+  /**
+   * @brief Delete the optimizer.
+   */
+  virtual ~Interface() noexcept = default;
+
+  /**
+   * @brief Allocate and reset the state for a layer of given dimensions.
+   *
+   * @param[in] nodeCount The number of nodes in the layer.
+   * @param[in] weightCount The number of weights per node in the layer.
+   *
+   * @return True if the state was allocated, or false on error.
+   */
+  virtual bool init(const size_t nodeCount, const size_t weightCount) = 0;
+
+  /**
+   * @brief Update the parameters of a layer with the given gradients.
+   *
+   *        The gradients point in the descent direction, i.e. plain gradient
+   *        descent would update each parameter as
+   *        parameter += learning_rate * gradient.
+   *
+   * @param[in, out] weights The weights to update, [node][weight].
+   * @param[in, out] bias The bias values to update, [node].
+   * @param[in] weightGradient Weight gradients, [node][weight].
+   * @param[in] biasGradient Bias gradients, [node].
+   * @param[in] learningRate Learning rate to use for the update.
+   *
+   * @return True if the parameters were updated, or false on error.
+   */
+  virtual bool update(ml::Matrix2d &weights, ml::Matrix1d &bias,
+                      const ml::Matrix2d &weightGradient,
+                      const ml::Matrix1d &biasGradient,
+                      const double learningRate) = 0;
+
+  /**
+   * @brief Get the size of the per-parameter state.
+   *
+   * @return The number of bytes of state values currently allocated.
+   */
+  virtual size_t stateBytes() const = 0;
+};
+} // namespace ml::optimizer
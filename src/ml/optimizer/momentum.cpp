@@ -0,0 +1,59 @@
+/**
+ * @brief Momentum optimizer implementation details.
+ */
+#include <zephyr/sys/printk.h>
+
+#include "ml/dense_layer/kernels.hpp"
+#include "ml/optimizer/momentum.hpp"
+
+namespace ml::optimizer {
+// -----------------------------------------------------------------------------
+Momentum::Momentum(const double momentum, const bool nesterov) noexcept
+    : myWeightVelocity{}, myBiasVelocity{}, myMomentum{momentum},
+      myNesterov{nesterov} {}
+
+// -----------------------------------------------------------------------------
+bool Momentum::init(const size_t nodeCount, const size_t weightCount) noexcept {
+  // All velocities start at zero.
+  return ml::dense_layer::resizeZero(myWeightVelocity, nodeCount,
+                                     weightCount) &&
+         ml::dense_layer::resizeZero(myBiasVelocity, nodeCount);
+}
+
+// -----------------------------------------------------------------------------
+bool Momentum::update(ml::Matrix2d &weights, ml::Matrix1d &bias,
+                      const ml::Matrix2d &weightGradient,
+                      const ml::Matrix1d &biasGradient,
+                      const double learningRate) noexcept {
+  // Make sure the state was allocated for a layer of this size.
+  if (bias.size() != myBiasVelocity.size()) {
+    printk("optimizer state mismatch: expected %u actual %u\n",
+           (unsigned)myBiasVelocity.size(), (unsigned)bias.size());
+    return false;
+  }
+
+  for (size_t i{}; i < bias.size(); ++i) {
+    bias[i] += learningRate * step(myBiasVelocity[i], biasGradient[i]);
+
+    for (size_t j{}; j < weights[i].size(); ++j) {
+      weights[i][j] +=
+          learningRate * step(myWeightVelocity[i][j], weightGradient[i][j]);
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+size_t Momentum::stateBytes() const noexcept {
+  const auto weightCount{myWeightVelocity.empty() ? 0U
+                                                  : myWeightVelocity[0].size()};
+  return requiredBytes(myBiasVelocity.size(), weightCount);
+}
+
+// -----------------------------------------------------------------------------
+double Momentum::step(double &velocity, const double gradient) const noexcept {
+  // Accumulate the velocity, then either follow it or look ahead along it.
+  velocity = myMomentum * velocity + gradient;
+  return myNesterov ? gradient + myMomentum * velocity : velocity;
+}
+} // namespace ml::optimizer
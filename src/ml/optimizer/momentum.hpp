@@ -0,0 +1,102 @@
+/**
+ * @brief Momentum optimizer implementation.
+ */
+#pragma once
+
+#include "ml/optimizer/interface.hpp"
+#include "ml/types.hpp"
+
+namespace ml::optimizer {
+/**
+ * @brief Gradient descent with (optionally Nesterov) momentum.
+ *
+ *        velocity = momentum * velocity + gradient
+ *        parameter += learning_rate * velocity                 (classic)
+ *        parameter += learning_rate * (gradient + momentum * velocity)
+ *                                                              (Nesterov)
+ */
+class Momentum final : public Interface {
+public:
+  /**
+   * @brief Create a new momentum optimizer.
+   *
+   * @param[in] momentum The momentum coefficient, 0 <= momentum < 1
+   *                     (default = 0.9).
+   * @param[in] nesterov True to use Nesterov momentum (default = false).
+   */
+  explicit Momentum(const double momentum = 0.9,
+                    const bool nesterov = false) noexcept;
+
+  /**
+   * @brief Delete the optimizer.
+   */
+  ~Momentum() noexcept override = default;
+
+  /**
+   * @brief Get the state size of a layer of given dimensions.
+   *
+   * @param[in] nodeCount The number of nodes in the layer.
+   * @param[in] weightCount The number of weights per node in the layer.
+   *
+   * @return The number of bytes of state values (one velocity per
+   *         parameter).
+   */
+  static constexpr size_t requiredBytes(const size_t nodeCount,
+                                        const size_t weightCount) noexcept {
+    return nodeCount * (weightCount + 1U) * sizeof(double);
+  }
+
+  /**
+   * @brief Allocate and reset the state for a layer of given dimensions.
+   *
+   * @param[in] nodeCount The number of nodes in the layer.
+   * @param[in] weightCount The number of weights per node in the layer.
+   *
+   * @return True if the state was allocated, or false on error.
+   */
+  bool init(const size_t nodeCount, const size_t weightCount) noexcept override;
+
+  /**
+   * @brief Update the parameters of a layer with the given gradients.
+   *
+   * @param[in, out] weights The weights to update, [node][weight].
+   * @param[in, out] bias The bias values to update, [node].
+   * @param[in] weightGradient Weight gradients, [node][weight].
+   * @param[in] biasGradient Bias gradients, [node].
+   * @param[in] learningRate Learning rate to use for the update.
+   *
+   * @return True if the parameters were updated, or false on error.
+   */
+  bool update(ml::Matrix2d &weights, ml::Matrix1d &bias,
+              const ml::Matrix2d &weightGradient,
+              const ml::Matrix1d &biasGradient,
+              const double learningRate) noexcept override;
+
+  /**
+   * @brief Get the size of the per-parameter state.
+   *
+   * @return The number of bytes of state values currently allocated.
+   */
+  size_t stateBytes() const noexcept override;
+
+  Momentum(const Momentum &) = delete;            // No copy constructor.
+  Momentum(Momentum &&) = delete;                 // No move constructor.
+  Momentum &operator=(const Momentum &) = delete; // No copy assignment.
+  Momentum &operator=(Momentum &&) = delete;      // No move assignment.
+
+private:
+  double step(double &velocity, const double gradient) const noexcept;
+
+  /** Velocity of each weight: [node][weight]. */
+  ml::Matrix2d myWeightVelocity;
+
+  /** Velocity of each bias value. */
+  ml::Matrix1d myBiasVelocity;
+
+  /** The momentum coefficient. */
+  const double myMomentum;
+
+  /** Indicates whether Nesterov momentum is used. */
+  const bool myNesterov;
+};
+} // namespace ml::optimizer
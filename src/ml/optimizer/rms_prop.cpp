@@ -0,0 +1,59 @@
+/**
+ * @brief RMSprop optimizer implementation details.
+ */
+#include <math.h>
+
+#include <zephyr/sys/printk.h>
+
+#include "ml/dense_layer/kernels.hpp"
+#include "ml/optimizer/rms_prop.hpp"
+
+namespace ml::optimizer {
+// -----------------------------------------------------------------------------
+RmsProp::RmsProp(const double decay, const double epsilon) noexcept
+    : myWeightSquare{}, myBiasSquare{}, myDecay{decay}, myEpsilon{epsilon} {}
+
+// -----------------------------------------------------------------------------
+bool RmsProp::init(const size_t nodeCount, const size_t weightCount) noexcept {
+  // All running averages start at zero.
+  return ml::dense_layer::resizeZero(myWeightSquare, nodeCount, weightCount) &&
+         ml::dense_layer::resizeZero(myBiasSquare, nodeCount);
+}
+
+// -----------------------------------------------------------------------------
+bool RmsProp::update(ml::Matrix2d &weights, ml::Matrix1d &bias,
+                     const ml::Matrix2d &weightGradient,
+                     const ml::Matrix1d &biasGradient,
+                     const double learningRate) noexcept {
+  // Make sure the state was allocated for a layer of this size.
+  if (bias.size() != myBiasSquare.size()) {
+    printk("optimizer state mismatch: expected %u actual %u\n",
+           (unsigned)myBiasSquare.size(), (unsigned)bias.size());
+    return false;
+  }
+
+  for (size_t i{}; i < bias.size(); ++i) {
+    bias[i] += learningRate * step(myBiasSquare[i], biasGradient[i]);
+
+    for (size_t j{}; j < weights[i].size(); ++j) {
+      weights[i][j] +=
+          learningRate * step(myWeightSquare[i][j], weightGradient[i][j]);
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+size_t RmsProp::stateBytes() const noexcept {
+  const auto weightCount{myWeightSquare.empty() ? 0U
+                                                : myWeightSquare[0].size()};
+  return requiredBytes(myBiasSquare.size(), weightCount);
+}
+
+// -----------------------------------------------------------------------------
+double RmsProp::step(double &square, const double gradient) const noexcept {
+  // Scale the gradient down by its running root mean square.
+  square = myDecay * square + (1.0 - myDecay) * gradient * gradient;
+  return gradient / (sqrt(square) + myEpsilon);
+}
+} // namespace ml::optimizer
@@ -0,0 +1,101 @@
+/**
+ * @brief RMSprop optimizer implementation.
+ */
+#pragma once
+
+#include "ml/optimizer/interface.hpp"
+#include "ml/types.hpp"
+
+namespace ml::optimizer {
+/**
+ * @brief RMSprop, gradient descent scaled by a running RMS of the gradient.
+ *
+ *        square = decay * square + (1 - decay) * gradient²
+ *        parameter += learning_rate * gradient / (sqrt(square) + epsilon)
+ */
+class RmsProp final : public Interface {
+public:
+  /**
+   * @brief Create a new RMSprop optimizer.
+   *
+   * @param[in] decay The decay rate of the running average, 0 <= decay < 1
+   *                  (default = 0.9).
+   * @param[in] epsilon Small value to avoid division by zero
+   *                    (default = 1e-8).
+   */
+  explicit RmsProp(const double decay = 0.9,
+                   const double epsilon = 1e-8) noexcept;
+
+  /**
+   * @brief Delete the optimizer.
+   */
+  ~RmsProp() noexcept override = default;
+
+  /**
+   * @brief Get the state size of a layer of given dimensions.
+   *
+   * @param[in] nodeCount The number of nodes in the layer.
+   * @param[in] weightCount The number of weights per node in the layer.
+   *
+   * @return The number of bytes of state values (one running average per
+   *         parameter).
+   */
+  static constexpr size_t requiredBytes(const size_t nodeCount,
+                                        const size_t weightCount) noexcept {
+    return nodeCount * (weightCount + 1U) * sizeof(double);
+  }
+
+  /**
+   * @brief Allocate and reset the state for a layer of given dimensions.
+   *
+   * @param[in] nodeCount The number of nodes in the layer.
+   * @param[in] weightCount The number of weights per node in the layer.
+   *
+   * @return True if the state was allocated, or false on error.
+   */
+  bool init(const size_t nodeCount, const size_t weightCount) noexcept override;
+
+  /**
+   * @brief Update the parameters of a layer with the given gradients.
+   *
+   * @param[in, out] weights The weights to update, [node][weight].
+   * @param[in, out] bias The bias values to update, [node].
+   * @param[in] weightGradient Weight gradients, [node][weight].
+   * @param[in] biasGradient Bias gradients, [node].
+   * @param[in] learningRate Learning rate to use for the update.
+   *
+   * @return True if the parameters were updated, or false on error.
+   */
+  bool update(ml::Matrix2d &weights, ml::Matrix1d &bias,
+              const ml::Matrix2d &weightGradient,
+              const ml::Matrix1d &biasGradient,
+              const double learningRate) noexcept override;
+
+  /**
+   * @brief Get the size of the per-parameter state.
+   *
+   * @return The number of bytes of state values currently allocated.
+   */
+  size_t stateBytes() const noexcept override;
+
+  RmsProp(const RmsProp &) = delete;            // No copy constructor.
+  RmsProp(RmsProp &&) = delete;                 // No move constructor.
+  RmsProp &operator=(const RmsProp &) = delete; // No copy assignment.
+  RmsProp &operator=(RmsProp &&) = delete;      // No move assignment.
+
+private:
+  double step(double &square, const double gradient) const noexcept;
+
+  /** Running average of the squared weight gradients: [node][weight]. */
+  ml::Matrix2d myWeightSquare;
+
+  /** Running average of the squared bias gradients. */
+  ml::Matrix1d myBiasSquare;
+
+  /** The decay rate of the running average. */
+  const double myDecay;
+
+  /** Small value to avoid division by zero. */
+  const double myEpsilon;
+};
+} // namespace ml::optimizer
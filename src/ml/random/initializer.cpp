@@ -0,0 +1,73 @@
+/**
+ * @brief Weight initializer implementation details.
+ */
+#include <math.h>
+
+#include "ml/random/initializer.hpp"
+
+namespace ml::random {
+namespace {
+/** Initial bias of ReLU nodes. */
+constexpr double ReluBias{0.1};
+
+// -----------------------------------------------------------------------------
+double variance(const ml::WeightInit init, const double fanIn,
+                const double fanOut) noexcept {
+  switch (init) {
+  case ml::WeightInit::XavierUniform:
+  case ml::WeightInit::XavierNormal:
+    return 2.0 / (fanIn + fanOut);
+  case ml::WeightInit::HeUniform:
+  case ml::WeightInit::HeNormal:
+    return 2.0 / fanIn;
+  default:
+    return 1.0 / fanIn;
+  }
+}
+
+// -----------------------------------------------------------------------------
+bool isUniform(const ml::WeightInit init) noexcept {
+  return (ml::WeightInit::XavierUniform == init) ||
+         (ml::WeightInit::HeUniform == init) ||
+         (ml::WeightInit::LeCunUniform == init);
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+ml::WeightInit defaultInit(const ml::ActFunc actFunc) noexcept {
+  return ml::ActFunc::Relu == actFunc ? ml::WeightInit::HeNormal
+                                      : ml::WeightInit::XavierNormal;
+}
+
+// -----------------------------------------------------------------------------
+void initialize(ml::WeightInit init, const ml::ActFunc actFunc,
+                ml::Matrix2d &weights, ml::Matrix1d &bias,
+                Prng &prng) noexcept {
+  if (ml::WeightInit::Default == init) {
+    init = defaultInit(actFunc);
+  }
+  const auto fanOut{static_cast<double>(weights.size())};
+  const auto fanIn{
+      static_cast<double>(weights.empty() ? 0U : weights[0].size())};
+
+  if (0.0 == fanIn) {
+    return;
+  }
+  const auto stddev{sqrt(variance(init, fanIn, fanOut))};
+
+  // A uniform distribution over [-limit, limit) has variance limit^2 / 3.
+  const auto limit{sqrt(3.0) * stddev};
+  const auto uniform{isUniform(init)};
+
+  // A small positive ReLU bias keeps units from starting out dead.
+  const auto biasValue{ml::ActFunc::Relu == actFunc ? ReluBias : 0.0};
+
+  for (size_t i{}; i < weights.size(); ++i) {
+    bias[i] = biasValue;
+
+    for (auto &weight : weights[i]) {
+      weight = uniform ? prng.uniform(-limit, limit) : prng.normal(0.0, stddev);
+    }
+  }
+}
+} // namespace ml::random
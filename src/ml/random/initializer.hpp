@@ -0,0 +1,42 @@
+/**
+ * @brief Weight initializers.
+ */
+#pragma once
+
+#include "ml/random/prng.hpp"
+#include "ml/types.hpp"
+
+namespace ml::random {
+/**
+ * @brief Get the initializer suited for the given activation function.
+ *
+ * @param[in] actFunc The activation function of the layer.
+ *
+ * @return He normal for ReLU, Xavier normal otherwise.
+ */
+ml::WeightInit defaultInit(const ml::ActFunc actFunc) noexcept;
+
+/**
+ * @brief Fill the weights of a layer with random initial values.
+ *
+ *        The bias values are set to zero, or to a small positive value for
+ *        ReLU layers so no node starts out inactive for every input. The
+ *        scale of the weights follows from the number of inputs (fan-in) and
+ *        nodes (fan-out) of the layer:
+ *
+ *        Xavier: variance = 2 / (fan_in + fan_out)
+ *        He:     variance = 2 / fan_in
+ *        LeCun:  variance = 1 / fan_in
+ *
+ *        Uniform variants draw from [-limit, limit) with the same variance.
+ *
+ * @param[in] init The initializer to use, Default picks one for actFunc.
+ * @param[in] actFunc The activation function of the layer.
+ * @param[in, out] weights The weights to fill, [node][weight].
+ * @param[out] bias The bias values to set, [node].
+ * @param[in, out] prng The generator to draw the values from.
+ */
+void initialize(ml::WeightInit init, const ml::ActFunc actFunc,
+                ml::Matrix2d &weights, ml::Matrix1d &bias,
+                Prng &prng) noexcept;
+} // namespace ml::random
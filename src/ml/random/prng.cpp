@@ -0,0 +1,21 @@
+/**
+ * @brief Pseudo-random number generator implementation details.
+ */
+#include <math.h>
+
+#include "ml/random/prng.hpp"
+
+namespace ml::random {
+namespace {
+/** M_PI is a POSIX extension, not part of standard C++. */
+constexpr double Pi{3.14159265358979323846};
+} // namespace
+
+// -----------------------------------------------------------------------------
+double Prng::normal(const double mean, const double stddev) noexcept {
+  // Box-Muller transform, 1 - u keeps the logarithm argument above 0.
+  const auto u1{1.0 - uniform()};
+  const auto u2{uniform()};
+  return mean + stddev * sqrt(-2.0 * log(u1)) * cos(2.0 * Pi * u2);
+}
+} // namespace ml::random
@@ -0,0 +1,130 @@
+/**
+ * @brief Seedable pseudo-random number generator.
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace ml::random {
+/**
+ * @brief xoshiro128** pseudo-random number generator.
+ *
+ *        Small (16 bytes of state) and fast on 32-bit cores. The state is
+ *        expanded from a 64-bit seed with SplitMix64, so equal seeds always
+ *        produce equal sequences. Generators hold no shared state and are
+ *        passed explicitly to whatever needs random numbers.
+ */
+class Prng final {
+public:
+  /** Seed used when none is given. */
+  static constexpr uint64_t DefaultSeed{0x853C49E6748FEA9BULL};
+
+  /**
+   * @brief Create a new generator.
+   *
+   * @param[in] seed The seed to start from (default = DefaultSeed).
+   */
+  explicit constexpr Prng(const uint64_t seed = DefaultSeed) noexcept
+      : myState{} {
+    this->seed(seed);
+  }
+
+  /**
+   * @brief Delete the generator.
+   */
+  ~Prng() noexcept = default;
+
+  /**
+   * @brief Restart the generator from the given seed.
+   *
+   * @param[in] seed The seed to start from.
+   */
+  constexpr void seed(uint64_t seed) noexcept {
+    // SplitMix64 spreads any seed, including 0, over the whole state.
+    for (size_t i{}; i < StateSize; i += 2U) {
+      seed += 0x9E3779B97F4A7C15ULL;
+      auto z{seed};
+      z = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+      z = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+      z ^= z >> 31U;
+      myState[i] = static_cast<uint32_t>(z);
+      myState[i + 1U] = static_cast<uint32_t>(z >> 32U);
+    }
+  }
+
+  /**
+   * @brief Get the next raw value.
+   *
+   * @return A uniformly distributed 32-bit value.
+   */
+  constexpr uint32_t next() noexcept {
+    const auto result{rotl(myState[1U] * 5U, 7U) * 9U};
+    const auto t{myState[1U] << 9U};
+
+    myState[2U] ^= myState[0U];
+    myState[3U] ^= myState[1U];
+    myState[1U] ^= myState[2U];
+    myState[0U] ^= myState[3U];
+    myState[2U] ^= t;
+    myState[3U] = rotl(myState[3U], 11U);
+    return result;
+  }
+
+  /**
+   * @brief Get a uniformly distributed value in [0, 1).
+   *
+   * @return The generated value.
+   */
+  constexpr double uniform() noexcept {
+    return static_cast<double>(next()) * (1.0 / 4294967296.0);
+  }
+
+  /**
+   * @brief Get a uniformly distributed value in [min, max).
+   *
+   * @param[in] min The lower bound of the range.
+   * @param[in] max The upper bound of the range.
+   *
+   * @return The generated value.
+   */
+  constexpr double uniform(const double min, const double max) noexcept {
+    return min + (max - min) * uniform();
+  }
+
+  /**
+   * @brief Get a uniformly distributed index in [0, count).
+   *
+   * @param[in] count The number of possible indices. Must exceed 0.
+   *
+   * @return The generated index.
+   */
+  constexpr size_t index(const size_t count) noexcept {
+    // Multiply-shift instead of modulo, avoids the division and most of the
+    // bias for small counts.
+    return static_cast<size_t>((static_cast<uint64_t>(next()) * count) >> 32U);
+  }
+
+  /**
+   * @brief Get a normally distributed value.
+   *
+   * @param[in] mean The mean of the distribution (default = 0).
+   * @param[in] stddev The standard deviation of the distribution
+   *                   (default = 1).
+   *
+   * @return The generated value.
+   */
+  double normal(const double mean = 0.0, const double stddev = 1.0) noexcept;
+
+private:
+  /** The number of 32-bit state words. */
+  static constexpr size_t StateSize{4U};
+
+  static constexpr uint32_t rotl(const uint32_t x, const unsigned k) noexcept {
+    return (x << k) | (x >> (32U - k));
+  }
+
+  /** The generator state. */
+  uint32_t myState[StateSize];
+};
+} // namespace ml::random
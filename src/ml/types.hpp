@@ -17,7 +17,66 @@ using Matrix2d = ctr::Vector<Matrix1d>;
  * @brief Enumeration of activation functions.
  */
 enum class ActFunc {
-  Relu, ///< ReLU (Rectified Linear Unit) => y = x if x > 0 else 0.
-  Tanh, ///< Tanh (hyperbolic tangent)    => -1 <= y <= 1.
+  Relu,    ///< ReLU (Rectified Linear Unit) => y = x if x > 0 else 0.
+  Tanh,    ///< Tanh (hyperbolic tangent)    => -1 <= y <= 1.
+  Softmax, ///< Softmax, output layers only  => y = exp(x) / sum(exp(x)).
+};
+
+/**
+ * @brief Enumeration of weight initializers.
+ */
+enum class WeightInit {
+  Default,       ///< He normal for ReLU, Xavier normal otherwise.
+  XavierUniform, ///< Xavier/Glorot, uniform distribution.
+  XavierNormal,  ///< Xavier/Glorot, normal distribution.
+  HeUniform,     ///< He, uniform distribution.
+  HeNormal,      ///< He, normal distribution.
+  LeCunUniform,  ///< LeCun, uniform distribution.
+  LeCunNormal,   ///< LeCun, normal distribution.
+};
+
+/**
+ * @brief Enumeration of quantized weight levels.
+ */
+enum class WeightLevels {
+  Binary,  ///< Weights are -scale or +scale.
+  Ternary, ///< Weights are -scale, 0 or +scale.
+};
+
+/**
+ * @brief Enumeration of simulated integer quantizations.
+ */
+enum class Quantization {
+  None, ///< Full precision.
+  Int8, ///< Signed 8-bit levels, -127 to 127.
+  Int4, ///< Signed 4-bit levels, -7 to 7.
+};
+
+/**
+ * @brief Enumeration of sample orders within an epoch.
+ */
+enum class SampleOrder {
+  Sequential, ///< Samples 0 to n - 1, the same every epoch.
+  Shuffled,   ///< A new random permutation every epoch.
+  Stratified, ///< Shuffled, every class spread evenly over the epoch.
+  Balanced,   ///< Classes in turn, small classes are repeated.
+};
+
+/**
+ * @brief Enumeration of input normalizations.
+ */
+enum class Normalization {
+  Standardize, ///< Zero mean and unit standard deviation.
+  MinMax,      ///< Scaled to the range 0 - 1.
+};
+
+/**
+ * @brief Enumeration of optimizers, see ml::optimizer.
+ */
+enum class Optimizer {
+  None,     ///< Plain gradient descent, no state.
+  Momentum, ///< One velocity per parameter.
+  RmsProp,  ///< One mean square per parameter.
+  Adam,     ///< Two moments per parameter.
 };
 } // namespace ml